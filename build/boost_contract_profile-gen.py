@@ -0,0 +1,83 @@
+
+# Generate header from call site profile recorded by an instrumented run:
+#   python boost_contract_profile-gen.py PROFILE [MIN_NS [SAMPLE]] > HEADER
+# Where PROFILE is the output of boost::contract::write_call_site_profile,
+# call sites that never failed and whose checks cost at least MIN_NS
+# nanoseconds on average (default 1000) are disabled, and they are sampled once
+# every SAMPLE calls if SAMPLE is not 0 (default 0).
+
+# Copyright (C) 2008-2018 Lorenzo Caminiti
+# Distributed under the Boost Software License, Version 1.0 (see accompanying
+# file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+# See: https://lcaminiti.github.io/boost-contract
+
+import sys
+
+if len(sys.argv) < 2 or len(sys.argv) > 4:
+    sys.exit('usage: python boost_contract_profile-gen.py PROFILE ' +
+            '[MIN_NS [SAMPLE]]')
+profile = sys.argv[1]
+min_ns = int(sys.argv[2]) if len(sys.argv) > 2 else 1000
+sample = int(sys.argv[3]) if len(sys.argv) > 3 else 0
+
+def literal(s): # C++ string literal (e.g., for Windows paths).
+    return '"' + s.replace('\\', '\\\\').replace('"', '\\"').replace(
+            '\t', '\\t').replace('\n', '\\n') + '"'
+
+def unescape(field): # Undo escapes of write_call_site_profile.
+    chars = []
+    i = 0
+    while i < len(field):
+        c = field[i]
+        if c == '\\' and i + 1 < len(field):
+            i += 1
+            c = {'t': '\t', 'n': '\n'}.get(field[i], field[i])
+        chars.append(c)
+        i += 1
+    return ''.join(chars)
+
+elided = []
+for number, line in enumerate(open(profile), 1):
+    line = line.rstrip('\r\n') # Not strip (empty name is first field).
+    if not line or line.startswith('#'): continue
+    fields = line.split('\t') # Names and files can have spaces.
+    if len(fields) != 5:
+        sys.exit('{0}:{1}: expected 5 tab-separated fields'.format(profile,
+                number))
+    name, site = unescape(fields[0]), unescape(fields[1])
+    checks, failures, ns = int(fields[2]), int(fields[3]), int(fields[4])
+    # Never elide sites that failed, or that were never checked.
+    if failures == 0 and checks > 0 and ns // checks >= min_ns:
+        elided.append((site, name, checks, ns // checks))
+
+print('''
+// Generated file `python boost_contract_profile-gen.py {0} {1} {2}`.
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: https://lcaminiti.github.io/boost-contract
+
+#ifndef BOOST_CONTRACT_PROFILE_GEN_HPP_
+#define BOOST_CONTRACT_PROFILE_GEN_HPP_
+
+#include <boost/contract/core/call_site.hpp>
+
+namespace boost_contract_profile {{
+
+// Call at process start (before contracted functions are called).
+inline void apply() {{'''.format(profile, min_ns, sample))
+for site, name, checks, avg_ns in elided: # Name quoted (could have new-lines).
+    print('    // {0}: {1} checks, 0 failures, {2} ns per check.'.format(
+            literal(name), checks, avg_ns))
+    print('    boost::contract::set_call_site_enabled({0}, false);'.format(
+            literal(site)))
+    if sample:
+        print('    boost::contract::set_call_site_sampling({0}, {1});'.format(
+                literal(site), sample))
+print('''}}
+
+}} // namespace
+
+#endif // #include guard
+'''.format())
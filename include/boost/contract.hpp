@@ -15,6 +15,9 @@ and can be included one-by-one to reduce the amount of code to compile from this
 library in user code (but this was measured to not make an appreciable
 difference in compile-time so <c>boost/contract.hpp</c> can be included directly
 in most cases).
+This header only depends on the configuration macros so it can also be
+precompiled once per configuration (see
+@RefSect{extras.precompiled_headers, Precompiled Headers}).
 Instead the headers <c>boost/contract/core/\*.hpp</c> are not independent from
 other library headers and they are automatically included by the
 <c>boost/contract/\*.hpp</c> headers (so the <c>boost/contract/core/\*.hpp</c>
@@ -31,10 +34,18 @@ never be used directly by programmers.
 
 #include <boost/contract/assert.hpp>
 #include <boost/contract/base_types.hpp>
+#include <boost/contract/bulk.hpp>
 #include <boost/contract/call_if.hpp>
+#include <boost/contract/constexpr.hpp>
 #include <boost/contract/constructor.hpp>
+#include <boost/contract/contract_policy.hpp>
 #include <boost/contract/destructor.hpp>
 #include <boost/contract/function.hpp>
+#include <boost/contract/invariant_policy.hpp>
+#include <boost/contract/invariant_version.hpp>
+#include <boost/contract/invariant_view.hpp>
+#include <boost/contract/multiversion.hpp>
+#include <boost/contract/static_invariant_epoch.hpp>
 #include <boost/contract/check.hpp>
 #include <boost/contract/old.hpp>
 #include <boost/contract/override.hpp>
@@ -61,6 +61,52 @@ Assert contract conditions.
         BOOST_CONTRACT_DETAIL_NOOP
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Assert contract conditions reporting the values of their operands on
+    failure.
+
+    This is used like @RefMacro{BOOST_CONTRACT_ASSERT}, but when the asserted
+    condition is a single comparison (<c>==</c>, <c>!=</c>, <c><</c>,
+    <c><=</c>, <c>></c>, <c>>=</c>) or a single value and the assertion fails,
+    its operands are captured by reference and formatted (using
+    <c>operator<<</c> when available, @c ? otherwise).
+    Formatted values are reported by
+    @RefMemberFunc{boost::contract::assertion_failure, values} (and
+    @RefMemberFunc{boost::contract::assertion_failure, what}):
+
+    @code
+    BOOST_CONTRACT_ASSERT_EXPR(x < max); // On failure: "... failed for 10 < 3".
+    BOOST_CONTRACT_ASSERT_EXPR((x > 0 && x < max)); // Parenthesize others.
+    @endcode
+
+    When the assertion passes, this only evaluates the condition (so it compiles
+    to the same code as @RefMacro{BOOST_CONTRACT_ASSERT}).
+    When the assertion fails, operands are evaluated again to be formatted
+    (contract assertions should not have side effects anyway).
+    Operands can use operators that bind tighter than comparisons (e.g.,
+    <c>x + 1 < max</c>), but conditions with other operators (e.g., @c &&,
+    <c>||</c>, @c ?:) must be wrapped within parenthesis (and then only their
+    overall value is reported).
+
+    @see    @RefSect{advanced.assertion_operand_values,
+            Assertion Operand Values}
+
+    @param cond Boolean contract condition to check.
+                (This is not a variadic macro parameter so any comma it might
+                contain must be protected by round parenthesis,
+                @c BOOST_CONTRACT_ASSERT_EXPR((cond)) will always work.)
+    */
+    #define BOOST_CONTRACT_ASSERT_EXPR(cond)
+#elif !defined(BOOST_CONTRACT_NO_ALL)
+    #include <boost/contract/detail/assert_expr.hpp>
+    #define BOOST_CONTRACT_ASSERT_EXPR(cond) \
+        BOOST_CONTRACT_DETAIL_ASSERT_EXPR(cond) /* no `;`  here */
+#else
+    #define BOOST_CONTRACT_ASSERT_EXPR(cond) \
+        BOOST_CONTRACT_DETAIL_NOOP
+#endif
+
 #ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
     /**
     Preferred way to assert contract conditions that are computationally
@@ -0,0 +1,209 @@
+
+#ifndef BOOST_CONTRACT_BULK_HPP_
+#define BOOST_CONTRACT_BULK_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Check contracts of many objects constructed or destructed together.
+*/
+
+#include <boost/contract/core/config.hpp>
+#ifndef BOOST_CONTRACT_NO_CONSTRUCTORS
+    #include <boost/contract/detail/operation/bulk_constructor.hpp>
+#endif
+#ifndef BOOST_CONTRACT_NO_DESTRUCTORS
+    #include <boost/contract/detail/operation/bulk_destructor.hpp>
+#endif
+#include <boost/config.hpp>
+
+namespace boost { namespace contract {
+
+/**
+Check constructor contracts of many objects once for the entire batch.
+
+While an object of this class is alive, the calling thread does not check
+contracts of the constructors of the specified class, declared using
+@RefFunc{boost::contract::constructor}.
+Instead, static class invariants are checked once when this object is
+constructed, and then static class invariants (once) and non-static class
+invariants of all constructed objects (in a loop that does not acquire locks,
+allocate memory, etc. per object) are checked by
+@RefMemberFunc{boost::contract::bulk_constructor, check}:
+
+@code
+std::vector<u> v;
+{
+    boost::contract::bulk_constructor<u> b;
+    v.resize(1000000); // Contracts of each u constructor not checked here...
+    b.check(v.begin(), v.end()); // ...but invariants checked here instead.
+}
+@endcode
+
+Postconditions and exception guarantees of the constructors are not checked for
+objects constructed in bulk (constructor preconditions are still checked, see
+@RefClass{boost::contract::constructor_precondition}).
+On compilers that do not support C++11 @c thread_local, constructor contracts
+are still checked for each object unless
+@RefMacro{BOOST_CONTRACT_DISABLE_THREADS} is defined (in addition to invariants
+checked by this class).
+
+@see @RefSect{advanced.bulk_construction_and_destruction,
+        Bulk Construction and Destruction}
+
+@tparam Class   The type of the class of the objects constructed in bulk.
+*/
+template<class Class>
+class bulk_constructor { // Non-copyable (as *).
+public:
+    /**
+    Start constructing objects in bulk (checking static class invariants).
+
+    @b Throws:  This can throw in case programmers specify failure handlers that
+                throw exceptions instead of terminating the program (see
+                @RefSect{advanced.throw_on_failures__and__noexcept__,
+                Throw on Failure}).
+    */
+    bulk_constructor() {
+        #ifndef BOOST_CONTRACT_NO_CONSTRUCTORS
+            cond_.initialize();
+        #endif
+    }
+
+    /**
+    Check class invariants of all objects constructed in bulk.
+
+    This must be called after all objects in the specified range have been
+    constructed, and it can be called multiple times (e.g., once per range of
+    objects constructed in bulk).
+
+    @b Throws:  This can throw in case programmers specify failure handlers that
+                throw exceptions instead of terminating the program (see
+                @RefSect{advanced.throw_on_failures__and__noexcept__,
+                Throw on Failure}).
+
+    @param first    Iterator to the first constructed object.
+    @param last     Iterator one past the last constructed object.
+    */
+    template<typename Iter>
+    void check(Iter
+        #ifndef BOOST_CONTRACT_NO_CONSTRUCTORS
+            first
+        #endif
+        , Iter
+        #ifndef BOOST_CONTRACT_NO_CONSTRUCTORS
+            last
+        #endif
+    ) {
+        #ifndef BOOST_CONTRACT_NO_CONSTRUCTORS
+            cond_.check(first, last);
+        #endif
+    }
+
+    /**
+    Stop constructing objects in bulk (so constructor contracts of the specified
+    class are checked again for each object).
+    */
+    ~bulk_constructor() BOOST_NOEXCEPT_IF(false) {}
+
+/** @cond */
+private:
+    bulk_constructor(bulk_constructor const&);
+    bulk_constructor& operator=(bulk_constructor const&);
+
+    #ifndef BOOST_CONTRACT_NO_CONSTRUCTORS
+        boost::contract::detail::bulk_constructor<Class> cond_;
+    #endif
+/** @endcond */
+};
+
+/**
+Check destructor contracts of many objects once for the entire batch.
+
+When an object of this class is constructed, it checks static class invariants
+(once) and non-static class invariants of all objects about to be destructed (in
+a loop that does not acquire locks, allocate memory, etc. per object).
+Then, while this object is alive, the calling thread does not check contracts of
+the destructors of the specified class, declared using
+@RefFunc{boost::contract::destructor}.
+Finally, static class invariants are checked once when this object is
+destructed:
+
+@code
+{
+    boost::contract::bulk_destructor<u> b(v.begin(), v.end()); // Invariants...
+    v.clear(); // ...so contracts of each u destructor not checked here.
+}
+@endcode
+
+Postconditions and exception guarantees of the destructors are not checked for
+objects destructed in bulk.
+On compilers that do not support C++11 @c thread_local, destructor contracts are
+still checked for each object unless @RefMacro{BOOST_CONTRACT_DISABLE_THREADS}
+is defined (in addition to invariants checked by this class).
+
+@see @RefSect{advanced.bulk_construction_and_destruction,
+        Bulk Construction and Destruction}
+
+@tparam Class   The type of the class of the objects destructed in bulk.
+*/
+template<class Class>
+class bulk_destructor { // Non-copyable (as *).
+public:
+    /**
+    Start destructing objects in bulk (checking class invariants of all objects
+    about to be destructed).
+
+    @b Throws:  This can throw in case programmers specify failure handlers that
+                throw exceptions instead of terminating the program (see
+                @RefSect{advanced.throw_on_failures__and__noexcept__,
+                Throw on Failure}).
+
+    @param first    Iterator to the first object to destruct.
+    @param last     Iterator one past the last object to destruct.
+    */
+    template<typename Iter>
+    bulk_destructor(Iter
+        #ifndef BOOST_CONTRACT_NO_DESTRUCTORS
+            first
+        #endif
+        , Iter
+        #ifndef BOOST_CONTRACT_NO_DESTRUCTORS
+            last
+        #endif
+    ) {
+        #ifndef BOOST_CONTRACT_NO_DESTRUCTORS
+            cond_.initialize(); // Defer first so dtor always resumes.
+            cond_.check(first, last);
+        #endif
+    }
+
+    /**
+    Stop destructing objects in bulk (checking static class invariants).
+
+    @b Throws:  This can throw in case programmers specify failure handlers that
+                throw exceptions instead of terminating the program (see
+                @RefSect{advanced.throw_on_failures__and__noexcept__,
+                Throw on Failure}).
+                (This is declared @c noexcept(false) since C++11.)
+    */
+    ~bulk_destructor() BOOST_NOEXCEPT_IF(false) {}
+
+/** @cond */
+private:
+    bulk_destructor(bulk_destructor const&);
+    bulk_destructor& operator=(bulk_destructor const&);
+
+    #ifndef BOOST_CONTRACT_NO_DESTRUCTORS
+        boost::contract::detail::bulk_destructor<Class> cond_;
+    #endif
+/** @endcond */
+};
+
+} } // namespace
+
+#endif // #include guard
+
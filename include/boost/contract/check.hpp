@@ -12,6 +12,8 @@ RAII object that checks contracts.
 */
 
 #include <boost/contract/core/config.hpp>
+#include <boost/contract/core/call_site.hpp>
+#include <boost/contract/core/domain.hpp>
 #include <boost/contract/core/check_macro.hpp>
 #include <boost/contract/core/specify.hpp>
 #include <boost/contract/core/exception.hpp> // For set_... (if always in code).
@@ -19,7 +21,6 @@ RAII object that checks contracts.
         defined(BOOST_CONTRACT_STATIC_LINK)
     #include <boost/contract/detail/condition/cond_base.hpp>
     #include <boost/contract/detail/auto_ptr.hpp>
-    #include <boost/contract/detail/debug.hpp>
 #endif
 #include <boost/contract/detail/check.hpp>
 #include <boost/config.hpp>
@@ -30,14 +31,59 @@ RAII object that checks contracts.
 
 #if !defined(BOOST_CONTRACT_NO_CONDITIONS) || \
         defined(BOOST_CONTRACT_STATIC_LINK)
+    // No cond_ (null) when contract policy of class selects no contract kind.
     #define BOOST_CONTRACT_CHECK_CTOR_DEF_(contract_type) \
         : cond_(const_cast<contract_type&>(contract).cond_.release()) \
         { \
-            BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-            cond_->initialize(); \
+            if(cond_) cond_->initialize(); \
         }
+
+    #if     defined(BOOST_CONTRACT_PROFILING) && \
+            !defined(BOOST_CONTRACT_NO_CONDITIONS)
+        // Time entry checks here, exit checks in dtor (as site set on cond).
+        #define BOOST_CONTRACT_CHECK_SITE_INIT_ \
+            { \
+                cond_->set_site(site); \
+                site.profile_check(); /* Counted even if entry fails. */ \
+                boost::uint64_t const start = \
+                        boost::contract::call_site::profile_now(); \
+                cond_->initialize(); \
+                site.profile_time(boost::contract::call_site::profile_now() - \
+                        start); \
+            }
+    #else
+        #define BOOST_CONTRACT_CHECK_SITE_INIT_ cond_->initialize();
+    #endif
+
+    #define BOOST_CONTRACT_CHECK_SITE_CTOR_DEF_(contract_type) \
+        : cond_(const_cast<contract_type&>(contract).cond_.release()) \
+        { \
+            if(!cond_) return; \
+            if(BOOST_LIKELY(site.enabled()) || site.sampled()) { \
+                BOOST_CONTRACT_CHECK_SITE_INIT_ \
+            } else { \
+                cond_->disable(); \
+                cond_->initialize(); \
+            } \
+        }
+
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        #define BOOST_CONTRACT_CHECK_DOMAIN_CTOR_DEF_(contract_type) \
+            : cond_(const_cast<contract_type&>(contract).cond_.release()) \
+            { \
+                if(!cond_) return; \
+                if(BOOST_UNLIKELY(!d.enabled())) cond_->disable(); \
+                else cond_->set_domain(d); \
+                cond_->initialize(); \
+            }
+    #else
+        #define BOOST_CONTRACT_CHECK_DOMAIN_CTOR_DEF_(contract_type) \
+            BOOST_CONTRACT_CHECK_CTOR_DEF_(contract_type)
+    #endif
 #else
     #define BOOST_CONTRACT_CHECK_CTOR_DEF_(contract_type) {}
+    #define BOOST_CONTRACT_CHECK_SITE_CTOR_DEF_(contract_type) {}
+    #define BOOST_CONTRACT_CHECK_DOMAIN_CTOR_DEF_(contract_type) {}
 #endif
 
 /** @endcond */
@@ -309,6 +355,131 @@ public:
         ;
     #endif
 
+    /**
+    Construct this object without checking the specified contract (the return
+    value of <c>boost::contract::function(boost::false_type)</c>).
+
+    This object checks nothing on construction and destruction (so it can be
+    optimized away completely).
+    This constructor is not declared @c explicit so initializations can use
+    assignment syntax @c =.
+
+    @see    @RefSect{extras.multiversioning, Multiversioning}
+    */
+    /* implicit */ check
+    /** @cond */ BOOST_PREVENT_MACRO_SUBSTITUTION /** @endcond */ (
+            specify_unchecked const& /* contract */) {}
+
+    /**
+    Construct this object to check the specified contract only if the specified
+    call site is enabled.
+
+    This is the same as constructing this object from @p contract alone, but
+    when @p site is disabled (see
+    @RefFunc{boost::contract::set_call_site_enabled}) no contract assertion is
+    checked (neither on construction nor on destruction of this object) and no
+    old value is copied by the functor passed to @c .old(...), unless the call
+    is sampled (see @RefFunc{boost::contract::set_call_site_sampling}).
+    Old values copied where old value pointers are declared (using
+    @RefMacro{BOOST_CONTRACT_OLDOF} before this object is constructed) are
+    still copied, and the contract is still allocated, when @p site is
+    disabled.
+    When @RefMacro{BOOST_CONTRACT_PROFILING} is defined, checks, failures, and
+    checking time of the contract are also recorded for @p site.
+
+    @b Throws:  This can throw in case programmers specify contract failure
+                handlers that throw exceptions instead of terminating the
+                program (see
+                @RefSect{advanced.throw_on_failures__and__noexcept__,
+                Throw on Failure}).
+
+    @param site     Call site of the enclosing function (usually declared using
+                    @RefMacro{BOOST_CONTRACT_CALL_SITE}).
+    @param contract Contract to be checked (usually the return value of
+                    @RefFunc{boost::contract::function},
+                    @RefFunc{boost::contract::constructor},
+                    @RefFunc{boost::contract::destructor}, or
+                    @RefFunc{boost::contract::public_function}).
+
+    @tparam Contract    Type of the specified contract (this is one of the
+                        @c boost::contract::specify_... types).
+
+    @see    @RefSect{extras.call_site_switches, Call Site Switches}
+    */
+    template<class Contract>
+    check /** @cond */ BOOST_PREVENT_MACRO_SUBSTITUTION /** @endcond */ (
+            boost::contract::call_site const& site, Contract const& contract)
+    #ifndef BOOST_CONTRACT_DETAIL_DOXYGEN
+        BOOST_CONTRACT_CHECK_SITE_CTOR_DEF_(Contract)
+    #else
+        ;
+    #endif
+
+    /**
+    Construct this object to check the specified contract in the specified
+    domain.
+
+    This is the same as constructing this object from @p contract alone, but
+    when @p d is at level @c boost::contract::domain_off no contract assertion
+    is checked (neither on construction nor on destruction of this object) and
+    no old value is copied by the functor passed to @c .old(...) (other old
+    values are still copied as for disabled call sites, see above).
+    Otherwise, failures of this contract are handled by the failure handlers
+    set by @p d (if any).
+
+    @b Throws:  This can throw in case programmers specify contract failure
+                handlers that throw exceptions instead of terminating the
+                program (see
+                @RefSect{advanced.throw_on_failures__and__noexcept__,
+                Throw on Failure}).
+
+    @param d        Domain of the contract (it must outlive this object).
+    @param contract Contract to be checked (usually the return value of
+                    @RefFunc{boost::contract::function},
+                    @RefFunc{boost::contract::constructor},
+                    @RefFunc{boost::contract::destructor}, or
+                    @RefFunc{boost::contract::public_function}).
+
+    @tparam Contract    Type of the specified contract (this is one of the
+                        @c boost::contract::specify_... types).
+
+    @see    @RefSect{extras.contract_domains, Contract Domains}
+    */
+    template<class Contract>
+    check /** @cond */ BOOST_PREVENT_MACRO_SUBSTITUTION /** @endcond */ (
+            boost::contract::domain const& d, Contract const& contract)
+    #ifndef BOOST_CONTRACT_DETAIL_DOXYGEN
+        BOOST_CONTRACT_CHECK_DOMAIN_CTOR_DEF_(Contract)
+    #else
+        ;
+    #endif
+
+    /**
+    Construct this object without checking the specified contract, for any
+    call site.
+
+    This object checks nothing on construction and destruction (see
+    <c>check(specify_unchecked const&)</c>).
+
+    @see    @RefSect{extras.call_site_switches, Call Site Switches}
+    */
+    check /** @cond */ BOOST_PREVENT_MACRO_SUBSTITUTION /** @endcond */ (
+            boost::contract::call_site const& /* site */,
+            specify_unchecked const& /* contract */) {}
+
+    /**
+    Construct this object without checking the specified contract, for any
+    domain.
+
+    This object checks nothing on construction and destruction (see
+    <c>check(specify_unchecked const&)</c>).
+
+    @see    @RefSect{extras.contract_domains, Contract Domains}
+    */
+    check /** @cond */ BOOST_PREVENT_MACRO_SUBSTITUTION /** @endcond */ (
+            boost::contract::domain const& /* d */,
+            specify_unchecked const& /* contract */) {}
+
     /**
     Destruct this object.
 
@@ -327,7 +498,19 @@ public:
     */
     ~check /** @cond */ BOOST_PREVENT_MACRO_SUBSTITUTION /** @endcond */ ()
         BOOST_NOEXCEPT_IF(false) /* allow auto_ptr dtor to throw */
-    {}
+    {
+        #if     defined(BOOST_CONTRACT_PROFILING) && \
+                !defined(BOOST_CONTRACT_NO_CONDITIONS)
+            if(cond_ && cond_->site()) { // Time exit checks (in cond dtor).
+                boost::contract::call_site const& site = *cond_->site();
+                boost::uint64_t const start =
+                        boost::contract::call_site::profile_now();
+                delete cond_.release();
+                site.profile_time(boost::contract::call_site::profile_now() -
+                        start);
+            }
+        #endif
+    }
 
 /** @cond */
 private:
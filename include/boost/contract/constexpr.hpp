@@ -0,0 +1,130 @@
+
+#ifndef BOOST_CONTRACT_CONSTEXPR_HPP_
+#define BOOST_CONTRACT_CONSTEXPR_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Program contracts of @c constexpr functions.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/noop.hpp>
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Assert a precondition of a @c constexpr function.
+
+    This expands to an expression that can be used in @c constexpr functions
+    (also in C++11, where @c constexpr functions consist of a single return
+    statement, using the comma operator):
+
+    @code
+    constexpr int half(int x) {
+        return BOOST_CONTRACT_CONSTEXPR_PRECONDITION(x >= 0), x / 2;
+    }
+    @endcode
+
+    When the function is evaluated at compile-time, a failed precondition is a
+    compiler error (and passing preconditions cost nothing at run-time).
+    When the function is called at run-time, a failed precondition throws
+    @RefClass{boost::contract::assertion_failure} and calls
+    @RefFunc{boost::contract::precondition_failure} (with
+    @RefEnum{boost::contract::from} set to @c from_function) like
+    preconditions of other functions.
+    This is disabled (and the condition is not evaluated) when
+    @RefMacro{BOOST_CONTRACT_NO_PRECONDITIONS} is defined.
+
+    @see    @RefSect{advanced.lambdas__loops__code_blocks__and__constexpr__,
+            Lambdas\, Loops\, Code Blocks (and constexpr)}
+
+    @param cond Boolean precondition to check.
+                (This is not a variadic macro parameter so any comma it might
+                contain must be protected by round parenthesis,
+                @c BOOST_CONTRACT_CONSTEXPR_PRECONDITION((cond)) will always
+                work.)
+    */
+    #define BOOST_CONTRACT_CONSTEXPR_PRECONDITION(cond)
+#elif !defined(BOOST_CONTRACT_NO_PRECONDITIONS)
+    #include <boost/contract/detail/constexpr.hpp>
+    #define BOOST_CONTRACT_CONSTEXPR_PRECONDITION(cond) \
+        BOOST_CONTRACT_DETAIL_CONSTEXPR_ASSERT(precondition_failed, cond)
+#else
+    #define BOOST_CONTRACT_CONSTEXPR_PRECONDITION(cond) \
+        BOOST_CONTRACT_DETAIL_NOOP
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Assert a postcondition of a @c constexpr function.
+
+    This is used like @RefMacro{BOOST_CONTRACT_CONSTEXPR_PRECONDITION} but
+    for postconditions (usually asserted on the result before returning it,
+    which requires C++14 @c constexpr functions):
+
+    @code
+    constexpr int absolute(int x) {
+        int const result = x < 0 ? -x : x;
+        BOOST_CONTRACT_CONSTEXPR_POSTCONDITION(result >= 0);
+        return result;
+    }
+    @endcode
+
+    When the function is called at run-time, a failed postcondition calls
+    @RefFunc{boost::contract::postcondition_failure}.
+    This is disabled (and the condition is not evaluated) when
+    @RefMacro{BOOST_CONTRACT_NO_POSTCONDITIONS} is defined.
+
+    @see    @RefSect{advanced.lambdas__loops__code_blocks__and__constexpr__,
+            Lambdas\, Loops\, Code Blocks (and constexpr)}
+
+    @param cond Boolean postcondition to check.
+                (This is not a variadic macro parameter so any comma it might
+                contain must be protected by round parenthesis,
+                @c BOOST_CONTRACT_CONSTEXPR_POSTCONDITION((cond)) will always
+                work.)
+    */
+    #define BOOST_CONTRACT_CONSTEXPR_POSTCONDITION(cond)
+#elif !defined(BOOST_CONTRACT_NO_POSTCONDITIONS)
+    #include <boost/contract/detail/constexpr.hpp>
+    #define BOOST_CONTRACT_CONSTEXPR_POSTCONDITION(cond) \
+        BOOST_CONTRACT_DETAIL_CONSTEXPR_ASSERT(postcondition_failed, cond)
+#else
+    #define BOOST_CONTRACT_CONSTEXPR_POSTCONDITION(cond) \
+        BOOST_CONTRACT_DETAIL_NOOP
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Assert an implementation check within a @c constexpr function.
+
+    This is used like @RefMacro{BOOST_CONTRACT_CONSTEXPR_PRECONDITION} but
+    for implementation checks.
+    When the function is called at run-time, a failed check calls
+    @RefFunc{boost::contract::check_failure}.
+    This is disabled (and the condition is not evaluated) when
+    @RefMacro{BOOST_CONTRACT_NO_CHECKS} is defined.
+
+    @see    @RefSect{advanced.lambdas__loops__code_blocks__and__constexpr__,
+            Lambdas\, Loops\, Code Blocks (and constexpr)}
+
+    @param cond Boolean condition to check.
+                (This is not a variadic macro parameter so any comma it might
+                contain must be protected by round parenthesis,
+                @c BOOST_CONTRACT_CONSTEXPR_CHECK((cond)) will always work.)
+    */
+    #define BOOST_CONTRACT_CONSTEXPR_CHECK(cond)
+#elif !defined(BOOST_CONTRACT_NO_CHECKS)
+    #include <boost/contract/detail/constexpr.hpp>
+    #define BOOST_CONTRACT_CONSTEXPR_CHECK(cond) \
+        BOOST_CONTRACT_DETAIL_CONSTEXPR_ASSERT(check_failed, cond)
+#else
+    #define BOOST_CONTRACT_CONSTEXPR_CHECK(cond) \
+        BOOST_CONTRACT_DETAIL_NOOP
+#endif
+
+#endif // #include guard
+
@@ -15,6 +15,7 @@ Program contracts for constructors.
 #include <boost/contract/core/specify.hpp>
 #include <boost/contract/core/access.hpp>
 #include <boost/contract/core/constructor_precondition.hpp>
+#include <boost/contract/contract_policy.hpp>
 #if     !defined(BOOST_CONTRACT_NO_CONSTRUCTORS) || \
         !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
          defined(BOOST_CONTRACT_STATIC_LINK)
@@ -95,6 +96,10 @@ specify_old_postcondition_except<> constructor(Class* obj) {
     #if     !defined(BOOST_CONTRACT_NO_CONSTRUCTORS) || \
             !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
              defined(BOOST_CONTRACT_STATIC_LINK)
+        // No contract allocated (but same specify type, so order checked).
+        if(boost::contract::detail::contract_policy_none<Class>::value) {
+            return specify_old_postcondition_except<>(0);
+        }
         return specify_old_postcondition_except<>(
                 new boost::contract::detail::constructor<Class>(obj));
     #else
@@ -0,0 +1,131 @@
+
+#ifndef BOOST_CONTRACT_CONTRACT_POLICY_HPP_
+#define BOOST_CONTRACT_CONTRACT_POLICY_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Select which contracts are checked per class at compile-time.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+
+namespace boost { namespace contract {
+
+/**
+Kinds of contracts that can be selected per class by
+@RefClass{boost::contract::contract_policy}.
+
+These values can be combined using the bitwise operators @c | and @c &.
+
+@see @RefSect{extras.contract_policies, Contract Policies}
+*/
+enum contract_kind {
+    /** No contract kind. */
+    policy_none = 0,
+
+    /** Class invariants (static and non-static) checked at entry. */
+    policy_entry_invariants = 1,
+
+    /** Class invariants (static and non-static) checked at exit. */
+    policy_exit_invariants = 2,
+
+    /** Class invariants checked at both entry and exit. */
+    policy_invariants = policy_entry_invariants | policy_exit_invariants,
+
+    /** Preconditions (including constructor preconditions). */
+    policy_preconditions = 4,
+
+    /**
+    Postconditions (old values are copied only if postconditions or exception
+    guarantees are checked).
+    */
+    policy_postconditions = 8,
+
+    /** Exception guarantees. */
+    policy_excepts = 16,
+
+    /** All contract kinds (this is the default for all classes). */
+    policy_all = policy_invariants | policy_preconditions |
+            policy_postconditions | policy_excepts
+};
+
+/**
+Trait to select which contracts are checked for a class at compile-time.
+
+By default, this trait is @c boost::contract::policy_all for all classes (so
+contracts of all classes are checked as configured by
+@RefMacro{BOOST_CONTRACT_NO_PRECONDITIONS}, etc.).
+Programmers can specialize this trait to a bitwise combination of
+@RefEnum{boost::contract::contract_kind} values to check only those kinds of
+contracts for constructors, destructors, and public functions of the specified
+class.
+For example, to not check exit invariants and postconditions of a class on the
+hot path of a program (while still checking them for all other classes):
+
+@code
+namespace boost { namespace contract {
+    template<>
+    struct contract_policy<hot_class> : boost::integral_constant<unsigned,
+            policy_all & ~(policy_exit_invariants | policy_postconditions)> {};
+} }
+@endcode
+
+Contracts not selected by this trait are never checked (as if they were not
+programmed) and their checking code is removed at compile-time (but, unless
+this trait is @c boost::contract::policy_none, contract objects are still
+allocated and the functors programming them are still stored).
+When this trait is @c boost::contract::policy_none, constructors, destructors,
+and public functions that are not virtual and do not override do not allocate
+contract objects at all (virtual and overriding public functions still do, as
+needed for subcontracting), while they still return the same types so the
+order of @c .precondition(...), @c .old(...), etc. is checked at compile-time
+as usual.
+Old values are copied only if postconditions or exception guarantees are
+selected, but only when they are copied by the functor passed to @c .old(...)
+(old values copied where old value pointers are declared using
+@RefMacro{BOOST_CONTRACT_OLDOF} are always copied).
+This trait can only disable contracts that are enabled by the configuration
+macros, it cannot enable contracts disabled by those macros.
+Contracts of non-member functions, private and protected member functions are
+not affected by this trait.
+
+@see @RefSect{extras.contract_policies, Contract Policies}
+
+@tparam C   Class (without @c const and @c volatile qualifiers) of the
+            contracts.
+*/
+template<class C>
+struct contract_policy : boost::integral_constant<unsigned, policy_all> {};
+
+} } // namespace
+
+/* PRIVATE */
+
+/** @cond */
+namespace boost { namespace contract { namespace detail {
+
+// Check contracts of given kinds for (possibly cv-qualified) class C.
+template<class C, unsigned Kinds>
+struct contract_policy_checks : boost::integral_constant<bool, (
+    boost::contract::contract_policy<typename boost::remove_cv<C>::type>::value
+            & Kinds) != 0
+> {};
+
+// No contract kind checked for C (so contracts of C not even allocated).
+template<class C>
+struct contract_policy_none : boost::integral_constant<bool,
+    boost::contract::contract_policy<typename boost::remove_cv<C>::type>::value
+            == boost::contract::policy_none
+> {};
+
+} } } // namespace
+/** @endcond */
+
+#endif // #include guard
+
@@ -19,8 +19,11 @@ Allow to declare invariants, base types, etc all as private members.
     #include <boost/contract/detail/type_traits/mirror.hpp>
 #endif
 #ifndef BOOST_CONTRACT_NO_INVARIANTS
+    #include <boost/contract/invariant_version.hpp>
     #include <boost/contract/detail/debug.hpp>
     #include <boost/function_types/property_tags.hpp>
+    #include <boost/type_traits/is_base_of.hpp>
+    #include <boost/type_traits/remove_cv.hpp>
     #include <boost/mpl/vector.hpp>
 #endif
 
@@ -156,6 +159,43 @@ private: // No public APIs (so users cannot use it directly by mistake).
             BOOST_CONTRACT_DETAIL_DEBUG(obj);
             obj->BOOST_CONTRACT_INVARIANT_FUNC();
         }
+
+        template<class C>
+        struct has_invariant_version : boost::is_base_of<
+            boost::contract::invariant_version,
+            typename boost::remove_cv<C>::type
+        > {};
+
+        // Address of data identifies C (linkers can fold identical functions
+        // so their addresses do not, but they cannot merge mutable data).
+        template<class C>
+        struct invariant_class_id { static char value; };
+
+        // Upcasts below can access private bases as this class is a friend.
+
+        template<class C>
+        static bool invariant_checked(C const* obj) {
+            BOOST_CONTRACT_DETAIL_DEBUG(obj);
+            boost::contract::invariant_version const* v = obj;
+            return v->checked(&invariant_class_id<
+                    typename boost::remove_cv<C>::type>::value);
+        }
+
+        template<class C>
+        static void invariant_check(C const* obj) {
+            BOOST_CONTRACT_DETAIL_DEBUG(obj);
+            boost::contract::invariant_version const* v = obj;
+            v->check(&invariant_class_id<
+                    typename boost::remove_cv<C>::type>::value);
+        }
+
+        template<class C>
+        static void invariant_uncheck(C const* obj) {
+            BOOST_CONTRACT_DETAIL_DEBUG(obj);
+            boost::contract::invariant_version const* v = obj;
+            v->uncheck(&invariant_class_id<
+                    typename boost::remove_cv<C>::type>::value);
+        }
     #endif
     
     // Friends (used to limit library's public API).
@@ -177,6 +217,13 @@ private: // No public APIs (so users cannot use it directly by mistake).
 /** @endcond */
 };
 
+/** @cond */
+#ifndef BOOST_CONTRACT_NO_INVARIANTS
+    template<class C>
+    char access::invariant_class_id<C>::value = 0;
+#endif
+/** @endcond */
+
 } } // namespace
 
 #endif // #include guard
@@ -0,0 +1,301 @@
+
+#ifndef BOOST_CONTRACT_CALL_SITE_HPP_
+#define BOOST_CONTRACT_CALL_SITE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Enable and disable contract checking of single call sites at run-time.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    #include <atomic>
+#endif
+#include <string>
+#include <iosfwd>
+#include <cstddef>
+
+/* PRIVATE */
+
+/** @cond */
+namespace boost { namespace contract { namespace call_site_ {
+    struct registry_traits;
+} } } // namespace
+/** @endcond */
+
+/* CODE */
+
+namespace boost { namespace contract {
+
+/**
+Descriptor of a contracted function that can be enabled and disabled at
+run-time.
+
+Call sites are usually declared as function-local @c static variables using
+@RefMacro{BOOST_CONTRACT_CALL_SITE} and passed to the constructor of
+@RefClass{boost::contract::check} together with the contract, for example:
+
+@code
+void f() {
+    BOOST_CONTRACT_CALL_SITE(site, "f");
+    boost::contract::check c(site, boost::contract::function()
+        .precondition(...)
+        ...
+    );
+    ...
+}
+@endcode
+
+Call sites are registered from construction to destruction (see
+@RefSect{extras.call_site_switches, Call Site Switches}), so they are usually
+@c static.
+
+@see @RefSect{extras.call_site_switches, Call Site Switches}
+*/
+class call_site : private boost::noncopyable {
+public:
+    /**
+    Construct and register this call site.
+
+    This call site is enabled unless a previous call to
+    @RefFunc{boost::contract::set_call_site_enabled} disabled its name or its
+    file and line.
+
+    @param name Name of this call site (usually the name of the function, this
+                must point to a string with static storage duration).
+    @param file File of this call site (usually @c __FILE__).
+    @param line Line of this call site (usually @c __LINE__).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    call_site(char const* name, char const* file, unsigned long line);
+
+    /**
+    Destruct and unregister this call site.
+
+    Profile counts of this call site are no longer written by
+    @RefFunc{boost::contract::write_call_site_profile} after it is destructed.
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    ~call_site();
+
+    /** Name of this call site. */
+    char const* name() const { return name_; }
+
+    /** File of this call site. */
+    char const* file() const { return file_; }
+
+    /** Line of this call site. */
+    unsigned long line() const { return line_; }
+
+    /**
+    Return @c true if contracts of this call site are checked.
+
+    This is a single relaxed load (on compilers that support C++11
+    @c std::atomic) so it can be checked every time the contracted function is
+    called.
+    */
+    bool enabled() const BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            return enabled_.load(std::memory_order_relaxed);
+        #else
+            return enabled_;
+        #endif
+    }
+
+    /**
+    Return @c true if contracts of this call site are checked even if it is
+    disabled, because the call is sampled.
+
+    This is called only for disabled call sites and it is a single relaxed load
+    when this call site is not sampled (see
+    @RefFunc{boost::contract::set_call_site_sampling}).
+    */
+    bool sampled() const BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            unsigned long const period = period_.load(
+                    std::memory_order_relaxed);
+            return period != 0 && samples_.fetch_add(1,
+                    std::memory_order_relaxed) % period == 0;
+        #else
+            return period_ != 0 && sampled_locked();
+        #endif
+    }
+
+    /**
+    Number of times contracts of this call site were checked (only counted when
+    @RefMacro{BOOST_CONTRACT_PROFILING} is defined).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    boost::uint64_t checks() const BOOST_NOEXCEPT_OR_NOTHROW;
+
+    /**
+    Number of contract failures at this call site (only counted when
+    @RefMacro{BOOST_CONTRACT_PROFILING} is defined).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    boost::uint64_t failures() const BOOST_NOEXCEPT_OR_NOTHROW;
+
+    /**
+    Total nanoseconds spent checking contracts of this call site (only measured
+    when @RefMacro{BOOST_CONTRACT_PROFILING} is defined).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    boost::uint64_t nanoseconds() const BOOST_NOEXCEPT_OR_NOTHROW;
+
+/** @cond */
+    // Used by contracts when BOOST_CONTRACT_PROFILING is defined.
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    static boost::uint64_t profile_now() BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void profile_check() const BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void profile_time(boost::uint64_t nanoseconds) const
+            BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void profile_failure() const BOOST_NOEXCEPT_OR_NOTHROW;
+
+private:
+    friend struct call_site_::registry_traits;
+
+    // For compilers without lock-free atomics.
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    bool sampled_locked() const BOOST_NOEXCEPT_OR_NOTHROW;
+
+    char const* name_;
+    char const* file_;
+    unsigned long line_;
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        std::atomic<bool> enabled_;
+        std::atomic<unsigned long> period_;
+        mutable std::atomic<unsigned long> samples_;
+        mutable std::atomic<boost::uint64_t> checks_;
+        mutable std::atomic<boost::uint64_t> failures_;
+        mutable std::atomic<boost::uint64_t> nanoseconds_;
+    #else // All set under mutex.
+        volatile bool enabled_;
+        volatile unsigned long period_;
+        mutable unsigned long samples_;
+        mutable boost::uint64_t checks_;
+        mutable boost::uint64_t failures_;
+        mutable boost::uint64_t nanoseconds_;
+    #endif
+    call_site* next_; // Registered sites as intrusive list.
+/** @endcond */
+};
+
+/**
+Enable or disable contract checking of call sites.
+
+This applies to all registered call sites that match @p site, and also to call
+sites matching @p site that are registered later (so call sites can be disabled
+before their functions are called for the first time).
+Calls to this function are applied in order (so a later call overrides an
+earlier one for the call sites matched by both).
+
+@b Throws: This can throw @c std::bad_alloc.
+
+@param site     Either the name of call sites (see
+                @RefClass{boost::contract::call_site}), or <c>file:line</c>
+                where @c file matches the end of call site files at a path
+                separator (e.g., <c>"src/f.cpp:12"</c> or <c>"f.cpp:12"</c>).
+@param enabled  @c true to check contracts of matched call sites, @c false to
+                skip them.
+
+@return Number of registered call sites matched by @p site.
+
+@see @RefSect{extras.call_site_switches, Call Site Switches}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+std::size_t set_call_site_enabled(std::string const& site, bool enabled);
+
+/**
+Check contracts of disabled call sites once every given number of calls.
+
+This applies to call sites matched by @p site as for
+@RefFunc{boost::contract::set_call_site_enabled} (also to call sites that are
+registered later), and it only affects call sites while they are disabled
+(enabled call sites always check their contracts).
+Sampling does not add any overhead to enabled call sites, and it adds a single
+relaxed load to disabled call sites that are not sampled (on compilers that
+support C++11 @c std::atomic).
+
+@b Throws: This can throw @c std::bad_alloc.
+
+@param site     Either the name of call sites or <c>file:line</c> (see
+                @RefFunc{boost::contract::set_call_site_enabled}).
+@param period   Check contracts of one call every @p period calls of matched
+                call sites while they are disabled (0 to never check them, this
+                is the default).
+
+@return Number of registered call sites matched by @p site.
+
+@see @RefSect{extras.call_site_profiles, Call Site Profiles}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+std::size_t set_call_site_sampling(std::string const& site,
+        unsigned long period);
+
+/**
+Write the profile of all registered call sites.
+
+This writes one line per call site sorted by file, line, and name (so profiles
+of different runs can be compared using @c diff), with the name, the
+<c>file:line</c>, the number of checks, the number of failures, and the
+nanoseconds spent checking contracts of the call site, separated by tabs
+(after a first comment line starting with @c #, tabs shown as spaces here):
+
+@code
+# Boost.Contract call site profile: name file:line checks failures nanoseconds
+f src/f.cpp:12 1000 0 250000
+@endcode
+
+Backslashes, tabs, and new-lines in names and files are written as
+<c>\\</c>, <c>\t</c>, and <c>\n</c> respectively (so names and files can
+contain spaces, and null names are written as empty fields).
+
+Checks, failures, and nanoseconds are always zero unless
+@RefMacro{BOOST_CONTRACT_PROFILING} is defined.
+Build scripts can then use <c>build/boost_contract_profile-gen.py</c> to
+generate a header that disables (or samples) call sites that are expensive and
+never failed.
+
+@b Throws: This can throw exceptions thrown by @p out.
+
+@param out  Output stream to write the profile to.
+
+@see @RefSect{extras.call_site_profiles, Call Site Profiles}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+void write_call_site_profile(std::ostream& out);
+
+} } // namespace
+
+/**
+Declare a function-local @c static call site.
+
+This declares a variable named @p var of type
+@RefClass{boost::contract::call_site} with the file and line where this macro is
+used.
+
+@param var  Name of the declared call site variable.
+@param name Name of the call site (a string literal).
+
+@see @RefSect{extras.call_site_switches, Call Site Switches}
+*/
+#define BOOST_CONTRACT_CALL_SITE(var, name) \
+    static boost::contract::call_site var(name, __FILE__, __LINE__)
+
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/core/call_site.hpp>
+#endif
+
+#endif // #include guard
+
@@ -55,6 +55,35 @@ Macros for implementation checks.
     #define BOOST_CONTRACT_CHECK(cond) /* nothing */
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Assert implementation check conditions reporting the values of their
+    operands on failure.
+
+    This is used like @RefMacro{BOOST_CONTRACT_CHECK}, but operands of single
+    comparisons are formatted on failure like for
+    @RefMacro{BOOST_CONTRACT_ASSERT_EXPR} (when the check passes, this only
+    evaluates the condition).
+
+    @see    @RefSect{advanced.assertion_operand_values,
+            Assertion Operand Values}
+
+    @param cond Boolean condition to check within implementation code (function
+                body, etc.).
+                (This is not a variadic macro parameter so any comma it might
+                contain must be protected by round parenthesis,
+                @c BOOST_CONTRACT_CHECK_EXPR((cond)) will always work.)
+    */
+    #define BOOST_CONTRACT_CHECK_EXPR(cond)
+#elif !defined(BOOST_CONTRACT_NO_CHECKS)
+    #include <boost/contract/detail/check.hpp>
+    #include <boost/contract/detail/assert_expr.hpp>
+    #define BOOST_CONTRACT_CHECK_EXPR(cond) \
+        BOOST_CONTRACT_DETAIL_CHECK(BOOST_CONTRACT_DETAIL_ASSERT_EXPR(cond))
+#else
+    #define BOOST_CONTRACT_CHECK_EXPR(cond) /* nothing */
+#endif
+
 #ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
     /**
     Preferred way to assert implementation check conditions that are
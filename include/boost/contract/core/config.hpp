@@ -359,6 +359,54 @@ Configure this library compile-time and run-time behaviours.
     #define BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
 #endif
 
+#ifndef BOOST_CONTRACT_MAX_CHECKING_DEPTH
+    /**
+    Maximum number of contracts that can be checked one nested into the other
+    (default to @c 1).
+
+    By default, assertion checking is disabled while checking other assertions
+    so nested contracts are never checked (this avoids infinite recursion in
+    user code).
+    Programmers can redefine this macro to a value greater than @c 1 so nested
+    contracts are checked until this many contracts are being checked one nested
+    into the other.
+    In that case, class invariants of an object are not checked again by nested
+    contracts while the contracts of that same object are already being checked
+    (but preconditions, postconditions, and static class invariants are).
+    This checks more nested contracts (e.g., of composite objects) while still
+    bounding the cost of contracts that recursively call the functions they
+    specify.
+    This macro has no effect when
+    @RefMacro{BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION} is defined (because then
+    all nested contracts are checked).
+
+    @see    @RefSect{extras.nested_contract_checking, Nested Contract Checking}
+    */
+    #define BOOST_CONTRACT_MAX_CHECKING_DEPTH 1
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro to disable assertions only for the thread checking other
+    assertions (undefined by default).
+
+    By default, assertion checking is disabled in all threads while any thread
+    is checking other assertions (and that needs a global lock unless
+    @RefMacro{BOOST_CONTRACT_DISABLE_THREADS} is defined).
+    When this macro is defined, nesting depths and objects being checked are
+    instead tracked separately for each thread (using C++11 @c thread_local,
+    without any lock), so contracts checked by other threads at the same time,
+    also on the same objects, are still checked.
+    This macro has no effect on compilers that do not support C++11
+    @c thread_local.
+    This macro must be defined (or left undefined) consistently for all
+    translation units of a program.
+
+    @see    @RefSect{extras.nested_contract_checking, Nested Contract Checking}
+    */
+    #define BOOST_CONTRACT_THREAD_LOCAL_CHECKING
+#endif
+
 #ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
     /**
     Define this macro to evaluate and check audit assertions at run-time
@@ -377,6 +425,46 @@ Configure this library compile-time and run-time behaviours.
     #define BOOST_CONTRACT_AUDITS
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro to count bytes of memory held by contracts (undefined by
+    default).
+
+    When this macro is defined, this library counts bytes allocated and released
+    for old value copies, condition objects, subcontracting queues, and large
+    functors passed to @c .precondition(...), etc.
+    These counts can then be read using
+    @RefFunc{boost::contract::thread_memory_usage} and
+    @RefFunc{boost::contract::process_memory_usage}.
+    Otherwise, this library does not count memory so there is no overhead (and
+    all these counts are always zero).
+    This macro must be defined (or left undefined) consistently for all
+    translation units of a program.
+
+    @see @RefSect{advanced.memory_accounting, Memory Accounting}
+    */
+    #define BOOST_CONTRACT_MEMORY_ACCOUNTING
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro to record costs and failures of contracts per call site
+    (undefined by default).
+
+    When this macro is defined, contracts checked via call sites (see
+    @RefClass{boost::contract::call_site}) count their checks and failures, and
+    measure the time spent checking them.
+    These counts can then be read using
+    @RefFunc{boost::contract::write_call_site_profile} (e.g., at the end of an
+    instrumented run of the program).
+    Otherwise, this library does not record profiles so there is no overhead
+    (and all these counts are always zero).
+
+    @see @RefSect{extras.call_site_profiles, Call Site Profiles}
+    */
+    #define BOOST_CONTRACT_PROFILING
+#endif
+
 #ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
     /**
     If defined, this library does not perform implementation checks (undefined
@@ -538,6 +626,24 @@ Configure this library compile-time and run-time behaviours.
     #define BOOST_CONTRACT_NO_EXIT_INVARIANTS
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    If defined, this library does not check non-static class invariants at exit
+    of @c const public functions (undefined by default).
+
+    This macro sets the default of the
+    @RefClass{boost::contract::check_const_exit_invariants} trait for all
+    classes (programmers can still specialize that trait to change this policy
+    for specific classes).
+    Unlike @RefMacro{BOOST_CONTRACT_NO_EXIT_INVARIANTS}, this macro does not
+    disable exit invariants of non-const public functions, constructors, or
+    destructors, and it does not reduce compile-time overhead.
+
+    @see    @RefSect{extras.invariant_policies, Invariant Policies}
+    */
+    #define BOOST_CONTRACT_NO_CONST_EXIT_INVARIANTS
+#endif
+
 #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
          defined(BOOST_CONTRACT_NO_ENTRY_INVARIANTS) && \
          defined(BOOST_CONTRACT_NO_EXIT_INVARIANTS)
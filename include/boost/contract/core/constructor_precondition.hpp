@@ -15,6 +15,7 @@ Program preconditions for constructors.
 #include <boost/contract/core/config.hpp>
 #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
     #include <boost/contract/core/exception.hpp>
+    #include <boost/contract/contract_policy.hpp>
     #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
         #include <boost/contract/detail/checking.hpp>
     #endif
@@ -101,6 +102,8 @@ public:
     template<typename F>
     explicit constructor_precondition(F const& f) {
         #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            if(!boost::contract::detail::contract_policy_checks<Class,
+                    boost::contract::policy_preconditions>::value) return;
             try {
                 #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                     if(boost::contract::detail::checking::already()) return;
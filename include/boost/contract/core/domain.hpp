@@ -0,0 +1,260 @@
+
+#ifndef BOOST_CONTRACT_DOMAIN_HPP_
+#define BOOST_CONTRACT_DOMAIN_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Named contract domains (to check contracts of components independently).
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/contract/detail/noop.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    #include <atomic>
+#endif
+#include <string>
+#include <cstddef>
+
+/* PRIVATE */
+
+/** @cond */
+namespace boost { namespace contract { namespace domain_ {
+    struct registry_traits;
+} } } // namespace
+/** @endcond */
+
+/* CODE */
+
+namespace boost { namespace contract {
+
+/**
+Run-time checking levels of contract domains.
+
+@see @RefSect{extras.contract_domains, Contract Domains}
+*/
+enum domain_level {
+    /** Contracts of the domain are not checked. */
+    domain_off,
+
+    /** Contracts of the domain are checked (this is the default). */
+    domain_on,
+
+    /**
+    Contracts of the domain are checked, including their audit assertions
+    (see @RefMacro{BOOST_CONTRACT_DOMAIN_ASSERT_AUDIT}).
+    */
+    domain_audit
+};
+
+/**
+Named group of contracts (e.g., of a library or namespace) that is checked at
+its own run-time level and with its own failure handlers.
+
+Domains are usually declared once per component as function-local @c static
+variables (so they can be used in headers and they are initialized when first
+used), and passed to the constructor of @RefClass{boost::contract::check}
+together with the contracts of the component, for example:
+
+@code
+namespace mylib {
+    inline boost::contract::domain& contracts() {
+        static boost::contract::domain d("mylib");
+        return d;
+    }
+
+    void f() {
+        boost::contract::check c(contracts(), boost::contract::function()
+            .precondition(...)
+            ...
+        );
+        ...
+    }
+}
+@endcode
+
+Domains are registered by name like call sites (see
+@RefClass{boost::contract::call_site}).
+
+@see @RefSect{extras.contract_domains, Contract Domains}
+*/
+class domain : private boost::noncopyable {
+public:
+    /**
+    Construct and register this domain.
+
+    This domain is at level @c domain_on unless a previous call to
+    @RefFunc{boost::contract::set_domain_level} set the level of its name.
+
+    @param name Name of this domain (this must point to a string with static
+                storage duration).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    explicit domain(char const* name);
+
+    /** Destruct and unregister this domain. */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    ~domain();
+
+    /** Name of this domain. */
+    char const* name() const { return name_; }
+
+    /**
+    Return the run-time checking level of this domain.
+
+    This is a single relaxed load (on compilers that support C++11
+    @c std::atomic) so it can be checked every time contracts of this domain
+    are checked.
+    */
+    domain_level level() const BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            return static_cast<domain_level>(
+                    level_.load(std::memory_order_relaxed));
+        #else
+            return static_cast<domain_level>(level_);
+        #endif
+    }
+
+    /** Return @c true if contracts of this domain are checked. */
+    bool enabled() const BOOST_NOEXCEPT_OR_NOTHROW {
+        return level() != domain_off;
+    }
+
+    /** Return @c true if audit assertions of this domain are checked. */
+    bool audit() const BOOST_NOEXCEPT_OR_NOTHROW {
+        return level() == domain_audit;
+    }
+
+    /**
+    Set the run-time checking level of this domain.
+
+    @b Throws: This is declared @c noexcept (or @c throw() before C++11).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    void set_level(domain_level level) BOOST_NOEXCEPT_OR_NOTHROW;
+
+    /**
+    Set failure handler for preconditions of this domain.
+
+    Failures for which this domain does not set a handler are handled by
+    scoped or process-wide failure handlers as usual.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    domain& set_precondition_failure(from_failure_handler const& f);
+
+    /**
+    Set failure handler for postconditions of this domain.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    domain& set_postcondition_failure(from_failure_handler const& f);
+
+    /**
+    Set failure handler for exception guarantees of this domain.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    domain& set_except_failure(from_failure_handler const& f);
+
+    /**
+    Set failure handler for old values copied at body of this domain.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    domain& set_old_failure(from_failure_handler const& f);
+
+    /**
+    Set failure handler for class invariants (at both entry and exit) of this
+    domain.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    /** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+    domain& set_invariant_failure(from_failure_handler const& f);
+
+/** @cond */
+    // Set handlers of this domain on given scope (used by failing contracts).
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void scope_handlers(scoped_failure_handlers& scope) const;
+
+private:
+    friend struct domain_::registry_traits;
+
+    char const* name_;
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        std::atomic<int> level_;
+    #else
+        volatile int level_; // Set under mutex.
+    #endif
+    from_failure_handler pre_; // Handlers set under mutex.
+    from_failure_handler post_;
+    from_failure_handler except_;
+    from_failure_handler old_;
+    from_failure_handler inv_;
+    domain* next_; // Registered domains as intrusive list.
+/** @endcond */
+};
+
+/**
+Set the run-time checking level of contract domains by name.
+
+This applies to all registered domains with the specified name, and also to
+domains with that name that are registered later (so domains can be configured
+before they are first used, e.g., at the start of @c main).
+
+@b Throws: This can throw @c std::bad_alloc.
+
+@param name     Name of the domains (see @RefClass{boost::contract::domain}).
+@param level    Run-time checking level to set.
+
+@return Number of registered domains named @p name.
+
+@see @RefSect{extras.contract_domains, Contract Domains}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+std::size_t set_domain_level(std::string const& name, domain_level level);
+
+} } // namespace
+
+/**
+Assert a computationally expensive condition only if the specified domain is at
+level @c boost::contract::domain_audit at run-time.
+
+This is similar to @RefMacro{BOOST_CONTRACT_ASSERT_AUDIT}, but audit assertions
+are selected per domain at run-time instead of for the entire program at
+compile-time (so the condition is always compiled and evaluated only when the
+domain is at audit level).
+
+@param domain   Domain of the contract programming this assertion (an lvalue of
+                type @RefClass{boost::contract::domain}).
+@param cond     Boolean condition to check (as for
+                @RefMacro{BOOST_CONTRACT_ASSERT}).
+
+@see @RefSect{extras.contract_domains, Contract Domains}
+*/
+#define BOOST_CONTRACT_DOMAIN_ASSERT_AUDIT(domain, cond) \
+    ((domain).audit() ? \
+        BOOST_CONTRACT_ASSERT(cond) \
+    : \
+        BOOST_CONTRACT_DETAIL_NOOP \
+    ) /* no ; here */
+
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/core/domain.hpp>
+#endif
+
+#endif // #include guard
+
@@ -18,6 +18,7 @@ Handle contract assertion failures.
 #include <boost/config.hpp>
 #include <exception>
 #include <string>
+#include <cstddef>
 
 // NOTE: This code should not change (not even its impl) based on the
 // CONTRACT_NO_... macros. For example, preconditions_failure() should still
@@ -48,14 +49,125 @@ from this class will do that (inheriting from @c std::exception,
 */
 class BOOST_CONTRACT_DETAIL_DECLSPEC exception {
 public:
+    /**
+    Construct this object (capturing the call stack if enabled).
+
+    If stack capture was enabled by
+    @RefFunc{boost::contract::set_stack_capture}, this captures the return
+    addresses of the calling functions (without symbolizing them) and it
+    allocates memory to store them (no return address is stored if that
+    allocation fails).
+    Capturing can lock mutexes internal to the stack unwinder (for example,
+    @c _Unwind_Backtrace can take the dynamic loader lock), so it is not
+    async-signal-safe.
+    Stacks are captured only on Linux (using the unwinder of GCC and Clang),
+    otherwise no return address is captured.
+    When stack capture is disabled, this neither allocates memory nor calls the
+    unwinder.
+
+    @b Throws: This is declared @c noexcept (or @c throw() before C++11).
+    */
+    exception() /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
+    /**
+    Copy this object (copying its captured return addresses, if any).
+
+    @b Throws: This is declared @c noexcept (or @c throw() before C++11).
+    */
+    exception(exception const& other)
+            /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
+    /**
+    Assign this object (copying captured return addresses, if any).
+
+    @b Throws: This is declared @c noexcept (or @c throw() before C++11).
+    */
+    exception& operator=(exception const& other)
+            /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
     /**
     Destruct this object.
 
     @b Throws: This is declared @c noexcept (or @c throw() before C++11).
     */
     virtual ~exception() /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
+    /**
+    Return addresses captured when this object was constructed (innermost call
+    first, null if none was captured).
+
+    Use @RefFunc{boost::contract::symbolize_stack} to get function names (when
+    reporting failures, or later using offline tools).
+    */
+    void* const* stack() const;
+
+    /**
+    Number of return addresses captured when this object was constructed (0 if
+    stack capture was not enabled).
+    */
+    std::size_t stack_size() const;
+
+/** @cond */
+private:
+    void copy_stack(exception const& other) BOOST_NOEXCEPT_OR_NOTHROW;
+
+    // Allocated only when stack is captured (so exceptions stay small).
+    void** stack_;
+    std::size_t stack_size_;
+/** @endcond */
 };
 
+/**
+Enable or disable capturing call stacks in exceptions thrown by this library.
+
+When enabled, objects of @RefClass{boost::contract::exception} (and of derived
+classes like @RefClass{boost::contract::assertion_failure} and
+@RefClass{boost::contract::bad_virtual_result_cast}) capture the return
+addresses of the calling functions on construction.
+This is disabled by default.
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@param capture  @c true to capture call stacks, @c false otherwise.
+
+@see @RefSect{advanced.failure_call_stacks, Failure Call Stacks}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+void set_stack_capture(bool capture)
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
+/**
+Return whether call stacks are captured in exceptions thrown by this library.
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@see @RefSect{advanced.failure_call_stacks, Failure Call Stacks}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+bool get_stack_capture() /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
+/**
+Describe return addresses captured by @RefClass{boost::contract::exception}.
+
+This is not async-signal-safe (it can allocate memory, read symbol tables,
+etc.) so it should be called when reporting failures (not while handling
+signals).
+
+@b Throws: This can throw @c std::bad_alloc.
+
+@param stack    Return addresses (see
+                @RefMemberFunc{boost::contract::exception, stack}).
+@param size     Number of return addresses.
+
+@return One line per return address, listing its module, function name, and
+        offset (when these can be determined) followed by the address in
+        hexadecimal (that can be passed to offline tools like @c addr2line).
+
+@see @RefSect{advanced.failure_call_stacks, Failure Call Stacks}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+std::string symbolize_stack(void* const* stack, std::size_t size);
+
 #ifdef BOOST_MSVC
     #pragma warning(push)
     #pragma warning(disable: 4275) // Bases w/o DLL spec (bad_cast, etc).
@@ -156,6 +268,23 @@ public:
     @param code Text listing the source code of the assertion condition.
     */
     explicit assertion_failure(char const* code);
+
+    /**
+    Construct this object with file name, line number, source code text, and
+    operand values of an assertion condition.
+
+    This is used by @RefMacro{BOOST_CONTRACT_ASSERT_EXPR} and
+    @RefMacro{BOOST_CONTRACT_CHECK_EXPR} to report values of the operands of
+    failed assertion conditions (formatted only when assertions fail).
+
+    @param file Name of the file containing the assertion.
+    @param line Number of the line containing the assertion.
+    @param code Text listing the source code of the assertion condition.
+    @param values Text listing the values of the operands of the assertion
+                condition (e.g., <c>"1 < 0"</c> for <c>"x < y"</c>).
+    */
+    assertion_failure(char const* file, unsigned long line, char const* code,
+            std::string const& values);
     
     /**
     Destruct this object.
@@ -171,9 +300,10 @@ public:
     @b Throws: This is declared @c noexcept (or @c throw() before C++11).
     
     @return A string formatted similarly to the following:
-      <c>assertion "`code()`" failed: file "`file()`", line \`line()\`</c>.
-            File, line, and code will be omitted from this string if they were
-            not specified when constructing this object.
+      <c>assertion "`code()`" failed: file "`file()`", line \`line()\`</c>
+            (or <c>assertion "`code()`" failed for "`values()`": ...</c>).
+            File, line, code, and values will be omitted from this string if
+            they were not specified when constructing this object.
     */
     virtual char const* what() const
             /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
@@ -202,6 +332,14 @@ public:
     */
     char const* code() const;
 
+    /**
+    Text listing the values of the operands of the assertion condition.
+
+    @return Operand values as specified at construction (or @c "" if no operand
+            values were specified).
+    */
+    char const* values() const;
+
 /** @cond */
 private:
     void init();
@@ -209,6 +347,7 @@ private:
     char const* file_;
     unsigned long line_;
     char const* code_;
+    std::string values_;
     std::string what_;
 /** @endcond */
 };
@@ -254,6 +393,39 @@ invariants, preconditions, postconditions, and exception guarantees.
 */
 typedef boost::function<void (from)> from_failure_handler;
 
+// Declared here (not in core/failure_journal.hpp) as failure handlers record
+// failure events of this kind.
+
+/**
+Kind of contract failure recorded in failure events.
+
+@see @RefSect{advanced.failure_journal, Failure Journal}
+*/
+enum failure_kind {
+    /** Implementation check failed. */
+    failed_check,
+    /** Precondition failed. */
+    failed_precondition,
+    /** Postcondition failed. */
+    failed_postcondition,
+    /** Exception guarantee failed. */
+    failed_except,
+    /** Old value copy at body failed. */
+    failed_old,
+    /** Class invariant failed at entry. */
+    failed_entry_invariant,
+    /** Class invariant failed at exit. */
+    failed_exit_invariant
+};
+
+/** @cond */
+namespace failure_journal_ {
+    // Called by failure handlers (within the catch block of the failure).
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void record(failure_kind kind, from where) BOOST_NOEXCEPT_OR_NOTHROW;
+}
+/** @endcond */
+
 /**
 Type of assertion failure handler functions (without @c from parameter).
 
@@ -266,8 +438,21 @@ implementation checks.
 */
 typedef boost::function<void ()> failure_handler;
 
+class scoped_failure_handlers;
+
 /** @cond */
 namespace exception_ {
+    // Scoped failure handlers.
+    
+    class scopes; // Calls scoped handlers (impl in lib).
+
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    scoped_failure_handlers*& scope_unlocked() BOOST_NOEXCEPT_OR_NOTHROW;
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        BOOST_CONTRACT_DETAIL_DECLSPEC
+        scoped_failure_handlers*& scope_locked() BOOST_NOEXCEPT_OR_NOTHROW;
+    #endif // Else, scoped handlers never pushed (so ignored).
+
     // Check failure.
 
     BOOST_CONTRACT_DETAIL_DECLSPEC
@@ -408,6 +593,180 @@ namespace exception_ {
 }
 /** @endcond */
 
+/**
+Failure handlers of the calling thread while this object is alive.
+
+Failure handlers set by objects of this class are called (without locking any
+mutex) instead of the process-wide failure handlers set by
+@RefFunc{boost::contract::set_precondition_failure}, etc. when contract
+assertions fail on the thread that constructed the object and while the object
+is alive.
+Objects of this class form a stack (cheap to push and pop, without allocating
+memory) so the failure handler set by the most recently constructed object that
+is still alive is called, while failures for which no object in the stack set a
+handler are handled by the process-wide failure handlers as usual:
+
+@code
+void serve(request const& r) {
+    boost::contract::scoped_failure_handlers h;
+    h.set_precondition_failure([] (boost::contract::from) {
+        throw bad_request(); // Preconditions on untrusted input.
+    }); // Other failures handled as usual (e.g., terminate).
+    ...
+}
+@endcode
+
+While a scoped failure handler is being called, it is popped off the stack so it
+can call @RefFunc{boost::contract::precondition_failure}, etc. to delegate to
+handlers of enclosing scopes (or process-wide handlers).
+Objects of this class must be destructed in reverse order of construction on the
+thread that constructed them (e.g., declare them as local variables).
+On compilers that do not support C++11 @c thread_local, scoped failure handlers
+are ignored unless @RefMacro{BOOST_CONTRACT_DISABLE_THREADS} is defined.
+
+@see @RefSect{advanced.throw_on_failures__and__noexcept__, Throw on Failure}
+*/
+class scoped_failure_handlers { // Non-copyable (as *).
+public:
+    /**
+    Push this object on the stack of failure handlers of the calling thread
+    (without setting any failure handler yet).
+
+    @b Throws: This is declared @c noexcept (or @c throw() before C++11).
+    */
+    scoped_failure_handlers() /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW
+            /** @endcond */ : prev_(0) {
+        #ifndef BOOST_CONTRACT_DISABLE_THREADS
+            #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+                prev_ = exception_::scope_locked();
+                exception_::scope_locked() = this;
+            #endif
+        #else
+            prev_ = exception_::scope_unlocked();
+            exception_::scope_unlocked() = this;
+        #endif
+    }
+
+    /**
+    Pop this object from the stack of failure handlers of the calling thread.
+
+    @b Throws: This is declared @c noexcept (or @c throw() before C++11).
+    */
+    ~scoped_failure_handlers() /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW
+            /** @endcond */ {
+        #ifndef BOOST_CONTRACT_DISABLE_THREADS
+            #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+                exception_::scope_locked() = prev_;
+            #endif
+        #else
+            exception_::scope_unlocked() = prev_;
+        #endif
+    }
+
+    /**
+    Set failure handler for implementation checks in this scope.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    scoped_failure_handlers& set_check_failure(failure_handler const& f) {
+        check_ = f;
+        return *this;
+    }
+
+    /**
+    Set failure handler for preconditions in this scope.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    scoped_failure_handlers& set_precondition_failure(
+            from_failure_handler const& f) {
+        pre_ = f;
+        return *this;
+    }
+
+    /**
+    Set failure handler for postconditions in this scope.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    scoped_failure_handlers& set_postcondition_failure(
+            from_failure_handler const& f) {
+        post_ = f;
+        return *this;
+    }
+
+    /**
+    Set failure handler for exception guarantees in this scope.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    scoped_failure_handlers& set_except_failure(from_failure_handler const& f) {
+        except_ = f;
+        return *this;
+    }
+
+    /**
+    Set failure handler for old values copied at body in this scope.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    scoped_failure_handlers& set_old_failure(from_failure_handler const& f) {
+        old_ = f;
+        return *this;
+    }
+
+    /**
+    Set failure handler for class invariants at entry in this scope.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    scoped_failure_handlers& set_entry_invariant_failure(
+            from_failure_handler const& f) {
+        entry_inv_ = f;
+        return *this;
+    }
+
+    /**
+    Set failure handler for class invariants at exit in this scope.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    scoped_failure_handlers& set_exit_invariant_failure(
+            from_failure_handler const& f) {
+        exit_inv_ = f;
+        return *this;
+    }
+
+    /**
+    Set failure handler for class invariants (at both entry and exit) in this
+    scope.
+
+    @return This object (e.g., for concatenating function calls).
+    */
+    scoped_failure_handlers& set_invariant_failure(
+            from_failure_handler const& f) {
+        entry_inv_ = exit_inv_ = f;
+        return *this;
+    }
+
+/** @cond */
+private:
+    scoped_failure_handlers(scoped_failure_handlers const&);
+    scoped_failure_handlers& operator=(scoped_failure_handlers const&);
+
+    failure_handler check_;
+    from_failure_handler pre_;
+    from_failure_handler post_;
+    from_failure_handler except_;
+    from_failure_handler old_;
+    from_failure_handler entry_inv_;
+    from_failure_handler exit_inv_;
+    scoped_failure_handlers* prev_;
+
+    friend class exception_::scopes;
+/** @endcond */
+};
+
 } } // namespace
 
 /** @cond */
@@ -0,0 +1,153 @@
+
+#ifndef BOOST_CONTRACT_FAILURE_JOURNAL_HPP_
+#define BOOST_CONTRACT_FAILURE_JOURNAL_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Record contract failure events (optionally in a memory-mapped file).
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/exception.hpp> // For failure_kind and from.
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace boost { namespace contract {
+
+/**
+Contract failure event recorded in the failure journal.
+
+This is a POD type of fixed size so failure events can be recorded without
+allocating memory and also stored in memory-mapped files.
+Strings are truncated if longer than their arrays (and always terminated by a
+null character).
+
+@see @RefSect{advanced.failure_journal, Failure Journal}
+*/
+struct failure_event {
+    /** Failure time (nanoseconds since the epoch of the system clock). */
+    boost::uint64_t timestamp;
+
+    /** Hash of the identifier of the failing thread (0 if not supported). */
+    boost::uint64_t thread;
+
+    /** Kind of contract that failed. */
+    failure_kind kind;
+
+    /**
+    Operation that failed the contract (@c from_function for implementation
+    checks).
+    */
+    from where;
+
+    /** Line of the failed assertion (0 if unknown). */
+    unsigned long line;
+
+    /** File of the failed assertion (empty if unknown). */
+    char file[128];
+
+    /**
+    Code of the failed assertion (or @c what() of other standard exceptions
+    thrown by contracts, empty if unknown).
+    */
+    char code[128];
+};
+
+/**
+Start recording contract failure events in a ring buffer.
+
+After this is called, every time a contract fails this library records a
+@RefClass{boost::contract::failure_event} before calling the failure handler
+(set by @RefFunc{boost::contract::set_precondition_failure}, etc.).
+Events are recorded in a ring buffer shared by all threads (keeping only the
+most recent @p capacity events), without locking mutexes on compilers that
+support C++11 @c std::atomic, and without allocating memory or performing I/O on
+the failing thread.
+When more than @p capacity failures are recorded concurrently, an event is
+dropped if its slot in the ring buffer is still being written by another thread
+(so recorded events are never mixed up, but the failure journal might miss some
+events in this case).
+If @p path is specified, the ring buffer is mapped to that file (which is
+created or truncated) so the events recorded by a process that crashes can be
+read later by @RefFunc{boost::contract::read_failure_journal}.
+
+Calling this again replaces the ring buffer (previous ring buffers and memory
+mappings are released only at program exit, so failures concurrently being
+recorded never access released memory).
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@param capacity Number of events kept in the ring buffer (must be positive).
+@param path Path of the file to map the ring buffer to (0 to not map to files,
+            memory-mapped files are supported only on POSIX systems).
+
+@return @c true if the ring buffer was successfully allocated (and mapped to the
+        file), @c false otherwise (and then events are not recorded).
+
+@see @RefSect{advanced.failure_journal, Failure Journal}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+bool start_failure_journal(std::size_t capacity, char const* path = 0)
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
+/**
+Stop recording contract failure events.
+
+Events already recorded can no longer be read by
+@RefFunc{boost::contract::failure_journal_events} (but they remain in the
+memory-mapped file, if any).
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@see @RefSect{advanced.failure_journal, Failure Journal}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+void stop_failure_journal()
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
+/**
+Return contract failure events currently recorded (oldest first).
+
+Events being recorded by other threads while this is called are not returned.
+
+@b Throws: This can throw @c std::bad_alloc.
+
+@see @RefSect{advanced.failure_journal, Failure Journal}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+std::vector<failure_event> failure_journal_events();
+
+/**
+Return contract failure events recorded in a memory-mapped file (oldest first).
+
+This can be used to read the events recorded by a process (compiled with the
+same compiler and platform) after that process crashed.
+
+@b Throws: This can throw @c std::bad_alloc.
+
+@param path Path of the file passed to
+            @RefFunc{boost::contract::start_failure_journal}.
+
+@return Events recorded in the file (empty if the file cannot be read or it is
+        not a failure journal).
+
+@see @RefSect{advanced.failure_journal, Failure Journal}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+std::vector<failure_event> read_failure_journal(char const* path);
+
+} } // namespace
+
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/core/failure_journal.hpp>
+#endif
+
+#endif // #include guard
+
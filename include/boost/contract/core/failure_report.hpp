@@ -0,0 +1,104 @@
+
+#ifndef BOOST_CONTRACT_FAILURE_REPORT_HPP_
+#define BOOST_CONTRACT_FAILURE_REPORT_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Limit contract failure reports per call site (to deduplicate failure storms).
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+
+namespace boost { namespace contract {
+
+/**
+Decision on whether a contract failure should be reported by failure handlers.
+
+@see @RefSect{advanced.failure_report_limits, Failure Report Limits}
+*/
+struct failure_report {
+    /**
+    @c true if the failure handler should report this failure (e.g., log it),
+    @c false if this failure exceeds the report limit of its call site.
+    */
+    bool report;
+
+    /**
+    Number of failures at the same call site that were not reported since the
+    previous report (always 0 when @c report is @c false).
+    */
+    boost::uint64_t suppressed;
+};
+
+/**
+Set the maximum number of failures reported per call site per time interval.
+
+Call sites are identified by the file and line of the failed
+@RefClass{boost::contract::assertion_failure} (or by the dynamic type of other
+exceptions thrown by contracts).
+By default, all failures are reported.
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@param max_reports  Number of failures reported per call site per interval (0
+                    to report all failures).
+@param interval_ms  Length of intervals in milliseconds after which call sites
+                    can report again (0 for a single interval, so only the
+                    first @p max_reports failures of each call site are
+                    reported for the entire program execution).
+
+@see @RefSect{advanced.failure_report_limits, Failure Report Limits}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+void set_failure_report_limit(boost::uint64_t max_reports,
+        boost::uint64_t interval_ms)
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
+/**
+Count a contract failure against the report limit of its call site.
+
+This must be called by failure handlers (set by
+@RefFunc{boost::contract::set_precondition_failure}, etc.) at most once per
+failure, from within the handler (where the exception that caused the failure is
+active), for example:
+
+@code
+void log_and_throw(boost::contract::from) {
+    boost::contract::failure_report r = boost::contract::report_failure();
+    if(r.report) log(r.suppressed); // Not logged when exceeding limit...
+    throw; // ...but always handled (re-thrown here).
+}
+@endcode
+
+This does not lock mutexes or allocate memory on compilers that support C++11
+@c std::atomic.
+Up to a fixed number of distinct call sites are tracked (failures at call sites
+beyond that are always reported).
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@return Whether this failure should be reported (and how many failures were
+        not reported since the previous report at the same call site).
+
+@see @RefSect{advanced.failure_report_limits, Failure Report Limits}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+failure_report report_failure()
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */;
+
+} } // namespace
+
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/core/failure_report.hpp>
+#endif
+
+#endif // #include guard
+
@@ -0,0 +1,280 @@
+
+#ifndef BOOST_CONTRACT_MEMORY_HPP_
+#define BOOST_CONTRACT_MEMORY_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Account for memory held by contracts.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/config.hpp>
+#include <memory>
+#include <new>
+#include <cstddef>
+
+namespace boost { namespace contract {
+
+/** @cond */
+namespace memory_ {
+    enum kind {
+        old_values_kind,
+        conditions_kind,
+        virtual_queues_kind,
+        callables_kind,
+        kinds // Number of kinds above.
+    };
+}
+/** @endcond */
+
+/**
+Bytes of memory held by contracts.
+
+Bytes are counted only when @RefMacro{BOOST_CONTRACT_MEMORY_ACCOUNTING} is
+defined (otherwise all counts are always zero).
+Counts are allocated bytes minus released bytes, so counts of a given thread can
+be negative if that thread released memory allocated by other threads (e.g.,
+old value pointers copied across threads).
+
+@see @RefSect{advanced.memory_accounting, Memory Accounting}
+*/
+class memory_usage { // Copyable (as *).
+public:
+    /** Construct this object with all counts set to zero. */
+    memory_usage() : peak_(0) {
+        for(int k = 0; k < memory_::kinds; ++k) bytes_[k] = 0;
+    }
+
+    /**
+    Bytes held by old value copies (and their reference counts).
+
+    This does not include memory allocated by the copied values themselves
+    (e.g., the elements of an old value of type @c std::vector).
+    Old values stored in place within old value pointers (small trivially
+    copyable types) are not counted because they are not allocated separately.
+    */
+    std::ptrdiff_t old_values() const {
+        return bytes_[memory_::old_values_kind];
+    }
+
+    /**
+    Bytes held by condition objects (one per @RefClass{boost::contract::check}
+    object that is checking a contract).
+    */
+    std::ptrdiff_t conditions() const {
+        return bytes_[memory_::conditions_kind];
+    }
+
+    /**
+    Bytes held by the queues of @RefClass{boost::contract::virtual_} that pass
+    old value pointers along overridden functions for subcontracting (these
+    bytes do not include the old value copies themselves).
+    */
+    std::ptrdiff_t virtual_queues() const {
+        return bytes_[memory_::virtual_queues_kind];
+    }
+
+    /**
+    Bytes held by functors passed to @c .precondition(...), @c .old(...),
+    @c .postcondition(...), and @c .except(...) that are too large to be stored
+    within @c boost::function objects (e.g., lambdas capturing many variables).
+    */
+    std::ptrdiff_t callables() const {
+        return bytes_[memory_::callables_kind];
+    }
+
+    /** Sum of all bytes above. */
+    std::ptrdiff_t total() const {
+        std::ptrdiff_t t = 0;
+        for(int k = 0; k < memory_::kinds; ++k) t += bytes_[k];
+        return t;
+    }
+
+    /**
+    High-water mark of total bytes (since program start or since last reset).
+    */
+    std::ptrdiff_t peak() const { return peak_; }
+
+/** @cond */
+    std::ptrdiff_t bytes_[memory_::kinds];
+    std::ptrdiff_t peak_;
+/** @endcond */
+};
+
+/** @cond */
+namespace memory_ {
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void add_unlocked(kind k, std::ptrdiff_t bytes) BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void add_locked(kind k, std::ptrdiff_t bytes) BOOST_NOEXCEPT_OR_NOTHROW;
+
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    memory_usage thread_usage_unlocked() BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    memory_usage thread_usage_locked() BOOST_NOEXCEPT_OR_NOTHROW;
+
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void reset_thread_peak_unlocked() BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void reset_thread_peak_locked() BOOST_NOEXCEPT_OR_NOTHROW;
+
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    memory_usage process_usage_unlocked() BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    memory_usage process_usage_locked() BOOST_NOEXCEPT_OR_NOTHROW;
+}
+
+namespace detail {
+    // Called by this library where contracts (de)allocate memory.
+    inline void account_memory(
+        boost::contract::memory_::kind
+        #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+            k
+        #endif
+        ,
+        std::ptrdiff_t
+        #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+            bytes
+        #endif
+    ) BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+            #ifndef BOOST_CONTRACT_DISABLE_THREADS
+                boost::contract::memory_::add_locked(k, bytes);
+            #else
+                boost::contract::memory_::add_unlocked(k, bytes);
+            #endif
+        #endif
+    }
+
+    // Allocator for library containers that accounts their memory as Kind.
+    template<typename T, boost::contract::memory_::kind Kind>
+    class accounted_allocator {
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef T const* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template<typename U>
+        struct rebind { typedef accounted_allocator<U, Kind> other; };
+
+        accounted_allocator() BOOST_NOEXCEPT_OR_NOTHROW {}
+
+        template<typename U>
+        accounted_allocator(accounted_allocator<U, Kind> const&)
+                BOOST_NOEXCEPT_OR_NOTHROW {}
+
+        T* allocate(std::size_t n, void const* = 0) {
+            T* p = std::allocator<T>().allocate(n);
+            account_memory(Kind, std::ptrdiff_t(n * sizeof(T)));
+            return p;
+        }
+
+        void deallocate(T* p, std::size_t n) {
+            account_memory(Kind, -std::ptrdiff_t(n * sizeof(T)));
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        std::size_t max_size() const BOOST_NOEXCEPT_OR_NOTHROW {
+            return std::size_t(-1) / sizeof(T);
+        }
+
+        T* address(T& x) const { return &x; }
+        T const* address(T const& x) const { return &x; }
+
+        void construct(T* p, T const& x) { ::new(static_cast<void*>(p)) T(x); }
+        void destroy(T* p) { p->~T(); }
+    };
+
+    template<typename T, typename U, boost::contract::memory_::kind Kind>
+    inline bool operator==(accounted_allocator<T, Kind> const&,
+            accounted_allocator<U, Kind> const&) {
+        return true;
+    }
+
+    template<typename T, typename U, boost::contract::memory_::kind Kind>
+    inline bool operator!=(accounted_allocator<T, Kind> const&,
+            accounted_allocator<U, Kind> const&) {
+        return false;
+    }
+}
+/** @endcond */
+
+/**
+Return bytes currently held by contracts checked by the calling thread.
+
+This is cheap to call (it reads thread-local counters) so it can be called
+before and after given function calls to measure memory held by contracts at
+specific call sites (see also
+@RefFunc{boost::contract::reset_thread_memory_peak}), because this library does
+not keep counters per call site.
+On compilers that do not support C++11 @c thread_local, counters are shared by
+all threads (and locked unless @RefMacro{BOOST_CONTRACT_DISABLE_THREADS} is
+defined).
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@see @RefSect{advanced.memory_accounting, Memory Accounting}
+*/
+inline memory_usage thread_memory_usage()
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        return memory_::thread_usage_locked();
+    #else
+        return memory_::thread_usage_unlocked();
+    #endif
+}
+
+/**
+Reset the calling thread high-water mark to the total bytes it currently holds.
+
+For example, this can be called before a given (possibly recursive) function
+call so the peak bytes held by contracts during that call can then be read from
+@RefFunc{boost::contract::thread_memory_usage}.
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@see @RefSect{advanced.memory_accounting, Memory Accounting}
+*/
+inline void reset_thread_memory_peak()
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        memory_::reset_thread_peak_locked();
+    #else
+        memory_::reset_thread_peak_unlocked();
+    #endif
+}
+
+/**
+Return bytes currently held by contracts checked by all threads, and their
+process-wide high-water mark.
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@see @RefSect{advanced.memory_accounting, Memory Accounting}
+*/
+inline memory_usage process_memory_usage()
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        return memory_::process_usage_locked();
+    #else
+        return memory_::process_usage_unlocked();
+    #endif
+}
+
+} } // namespace
+
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/core/memory.hpp>
+#endif
+
+#endif // #include guard
+
@@ -25,11 +25,7 @@ specified in that order.
     #include <boost/contract/detail/auto_ptr.hpp>
     #include <boost/contract/detail/none.hpp>
 #endif
-#if     !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
-        !defined(BOOST_CONTRACT_NO_POSTCONDITIONS) || \
-        !defined(BOOST_CONTRACT_NO_EXCEPTS)
-    #include <boost/contract/detail/debug.hpp>
-#endif
+#include <boost/type_traits/integral_constant.hpp>
 #include <boost/config.hpp>
 
 // NOTE: No inheritance for faster run-times (macros to avoid duplicated code).
@@ -68,10 +64,10 @@ specified in that order.
     #define BOOST_CONTRACT_SPECIFY_COND_RELEASE_ /* nothing */
 #endif
 
+// No cond_ (null) when contract policy of class selects no contract kind.
 #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
     #define BOOST_CONTRACT_SPECIFY_PRECONDITION_IMPL_ \
-        BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-        cond_->set_pre(f); \
+        if(cond_) cond_->set_pre(f); \
         return specify_old_postcondition_except<VirtualResult>( \
                 BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
 #else
@@ -82,8 +78,7 @@ specified in that order.
         
 #ifndef BOOST_CONTRACT_NO_OLDS
     #define BOOST_CONTRACT_SPECIFY_OLD_IMPL_ \
-        BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-        cond_->set_old(f); \
+        if(cond_) cond_->set_old(f); \
         return specify_postcondition_except<VirtualResult>( \
                 BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
 #else
@@ -94,8 +89,7 @@ specified in that order.
             
 #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
     #define BOOST_CONTRACT_SPECIFY_POSTCONDITION_IMPL_ \
-        BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-        cond_->set_post(f); \
+        if(cond_) cond_->set_post(f); \
         return specify_except(BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
 #else
     #define BOOST_CONTRACT_SPECIFY_POSTCONDITION_IMPL_ \
@@ -104,8 +98,7 @@ specified in that order.
         
 #ifndef BOOST_CONTRACT_NO_EXCEPTS
     #define BOOST_CONTRACT_SPECIFY_EXCEPT_IMPL_ \
-        BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-        cond_->set_except(f); \
+        if(cond_) cond_->set_except(f); \
         return specify_nothing(BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
 #else
     #define BOOST_CONTRACT_SPECIFY_EXCEPT_IMPL_ \
@@ -663,6 +656,8 @@ private:
 
     friend class check;
     friend specify_precondition_old_postcondition_except<> function();
+    friend specify_precondition_old_postcondition_except<> function(
+            boost::true_type);
 
     template<class C>
     friend specify_precondition_old_postcondition_except<> public_function();
@@ -683,7 +678,45 @@ private:
 /** @endcond */
 };
 
+/**
+Allow to specify contracts that are never checked.
+
+This has the same member functions as
+@RefClass{boost::contract::specify_precondition_old_postcondition_except} but
+they ignore the specified functors, and it does not allocate nor check any
+contract (so code using it can be optimized to contain no contract code at all).
+This object is internally constructed by this library when users specify
+contracts calling <c>boost::contract::function(boost::false_type())</c> (that is
+why this class does not have a public constructor).
+
+@see @RefSect{extras.multiversioning, Multiversioning}
+*/
+class specify_unchecked { // Copyable (as empty).
+public:
+    /** Ignore the specified precondition functor. */
+    template<typename F>
+    specify_unchecked precondition(F const&) { return *this; }
+
+    /** Ignore the specified old value functor. */
+    template<typename F>
+    specify_unchecked old(F const&) { return *this; }
+
+    /** Ignore the specified postcondition functor. */
+    template<typename F>
+    specify_unchecked postcondition(F const&) { return *this; }
+
+    /** Ignore the specified exception guarantee functor. */
+    template<typename F>
+    specify_unchecked except(F const&) { return *this; }
+
+/** @cond */
+private:
+    specify_unchecked() {}
+
+    friend specify_unchecked function(boost::false_type);
+/** @endcond */
+};
+
 } } // namespace
 
 #endif // #include guard
-
@@ -20,7 +20,11 @@ Handle virtual public functions with contracts (for subcontracting).
     #include <boost/any.hpp>
 #endif
 #ifndef BOOST_CONTRACT_NO_OLDS
-    #include <boost/shared_ptr.hpp>
+    #include <boost/contract/detail/old_storage.hpp>
+    #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+        #include <boost/contract/core/memory.hpp>
+        #include <deque>
+    #endif
     #include <queue>
 #endif
 
@@ -73,15 +77,10 @@ private: // No public API (so users cannot use it directly by mistake).
         enum action_enum {
             // virtual_ always held/passed as ptr so nullptr used for user call.
             no_action,
-            #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
-                check_entry_inv,
-            #endif
+            // No inv actions (bases inv checked directly by overriding func).
             #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
                 check_pre,
             #endif
-            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
-                check_exit_inv,
-            #endif
             #ifndef BOOST_CONTRACT_NO_OLDS
                 // For outside .old(...).
                 push_old_init_copy,
@@ -134,8 +133,18 @@ private: // No public API (so users cannot use it directly by mistake).
         bool failed_;
     #endif
     #ifndef BOOST_CONTRACT_NO_OLDS
-        std::queue<boost::shared_ptr<void> > old_init_copies_;
-        std::queue<boost::shared_ptr<void> > old_ftor_copies_;
+        typedef boost::contract::detail::old_shared_ptr<void>::type
+                old_copy_ptr;
+        #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+            typedef std::queue<old_copy_ptr, std::deque<old_copy_ptr,
+                boost::contract::detail::accounted_allocator<old_copy_ptr,
+                        boost::contract::memory_::virtual_queues_kind> > >
+                    old_copy_queue;
+        #else
+            typedef std::queue<old_copy_ptr> old_copy_queue;
+        #endif
+        old_copy_queue old_init_copies_;
+        old_copy_queue old_ftor_copies_;
     #endif
     #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
         boost::any result_ptr_; // Result for virtual and overriding functions.
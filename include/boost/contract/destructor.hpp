@@ -14,6 +14,7 @@ Program contracts for destructors.
 #include <boost/contract/core/config.hpp>
 #include <boost/contract/core/specify.hpp>
 #include <boost/contract/core/access.hpp>
+#include <boost/contract/contract_policy.hpp>
 #if     !defined(BOOST_CONTRACT_NO_DESTRUCTORS) || \
         !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
          defined(BOOST_CONTRACT_STATIC_LINK)
@@ -94,6 +95,10 @@ specify_old_postcondition_except<> destructor(Class* obj) {
     #if     !defined(BOOST_CONTRACT_NO_DESTRUCTORS) || \
             !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
              defined(BOOST_CONTRACT_STATIC_LINK)
+        // No contract allocated (but same specify type, so order checked).
+        if(boost::contract::detail::contract_policy_none<Class>::value) {
+            return specify_old_postcondition_except<>(0);
+        }
         return specify_old_postcondition_except<>(
                 new boost::contract::detail::destructor<Class>(obj));
     #else
@@ -0,0 +1,157 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_ASSERT_EXPR_HPP_
+#define BOOST_CONTRACT_DETAIL_ASSERT_EXPR_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/detail/noop.hpp>
+#include <boost/type_traits/has_left_shift.hpp>
+#include <boost/call_traits.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/preprocessor/stringize.hpp>
+#include <boost/config.hpp>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+// In detail because used by both ASSERT_EXPR and CHECK_EXPR.
+// Condition evaluated as is so passing assertions compile to plain comparison.
+// On failure, `decompose <= a < b` binds as `(decompose <= a) < b` (`<=` has
+// relational precedence so arithmetic like in `a + 1 < b` is evaluated before
+// capture) so operands evaluated again (but assertions should have no side
+// effects) and captured within full-expression to be formatted (by ref, but
+// scalars by value via call_traits so their address not taken and compilers
+// keep them in registers on success path). Use ternary operator `?:` and no trailing `;`
+// here (same as for DETAIL_ASSERT).
+#define BOOST_CONTRACT_DETAIL_ASSERT_EXPR(cond) \
+    /* no if-statement here */ \
+    ((cond) ? \
+        BOOST_CONTRACT_DETAIL_NOOP \
+    : \
+        (boost::contract::detail::assert_expr::decompose( \
+                __FILE__, __LINE__, BOOST_PP_STRINGIZE(cond)) <= cond).fail() \
+    ) /* no ; here */
+
+namespace boost { namespace contract { namespace detail {
+    namespace assert_expr {
+
+// Operands that cannot be printed shown as `?` (so any operand type can be
+// used in assertions).
+template<typename T>
+void print(std::ostream& out, T const& value, boost::mpl::true_) {
+    out << value;
+}
+
+template<typename T>
+void print(std::ostream& out, T const&, boost::mpl::false_) { out << "?"; }
+
+template<typename T>
+void print(std::ostream& out, T const& value) {
+    print(out, value, boost::mpl::bool_<boost::has_left_shift<std::ostream&,
+            T const&>::value>());
+}
+
+inline void print(std::ostream& out, bool value) {
+    out << (value ? "true" : "false");
+}
+
+class site {
+public:
+    site(char const* file, unsigned long line, char const* code) :
+            file_(file), line_(line), code_(code) {}
+
+    void fail(std::string const& values) const {
+        throw boost::contract::assertion_failure(file_, line_, code_, values);
+    }
+
+private:
+    char const* file_;
+    unsigned long line_;
+    char const* code_;
+};
+
+template<typename L, typename R, class Op>
+class binary {
+public:
+    binary(site const& s, typename boost::call_traits<L>::param_type left,
+            typename boost::call_traits<R>::param_type right) :
+        site_(s), left_(left), right_(right)
+    {}
+
+    void fail() const {
+        std::ostringstream values;
+        print(values, left_);
+        values << " " << Op::name() << " ";
+        print(values, right_);
+        site_.fail(values.str());
+    }
+
+private:
+    site const& site_;
+    typename boost::call_traits<L>::param_type left_;
+    typename boost::call_traits<R>::param_type right_;
+};
+
+#define BOOST_CONTRACT_DETAIL_ASSERT_EXPR_NAME_(name_, op) \
+    struct name_ { static char const* name() { return #op; } };
+
+BOOST_CONTRACT_DETAIL_ASSERT_EXPR_NAME_(equal, ==)
+BOOST_CONTRACT_DETAIL_ASSERT_EXPR_NAME_(not_equal, !=)
+BOOST_CONTRACT_DETAIL_ASSERT_EXPR_NAME_(less, <)
+BOOST_CONTRACT_DETAIL_ASSERT_EXPR_NAME_(less_equal, <=)
+BOOST_CONTRACT_DETAIL_ASSERT_EXPR_NAME_(greater, >)
+BOOST_CONTRACT_DETAIL_ASSERT_EXPR_NAME_(greater_equal, >=)
+
+#undef BOOST_CONTRACT_DETAIL_ASSERT_EXPR_NAME_
+
+#define BOOST_CONTRACT_DETAIL_ASSERT_EXPR_OP_(name_, op) \
+    template<typename R> \
+    binary<L, R, name_> operator op(R const& right) const { \
+        return binary<L, R, name_>(site_, left_, right); \
+    }
+
+template<typename L>
+class unary {
+public:
+    unary(site const& s, typename boost::call_traits<L>::param_type left) :
+            site_(s), left_(left) {}
+
+    BOOST_CONTRACT_DETAIL_ASSERT_EXPR_OP_(equal, ==)
+    BOOST_CONTRACT_DETAIL_ASSERT_EXPR_OP_(not_equal, !=)
+    BOOST_CONTRACT_DETAIL_ASSERT_EXPR_OP_(less, <)
+    BOOST_CONTRACT_DETAIL_ASSERT_EXPR_OP_(less_equal, <=)
+    BOOST_CONTRACT_DETAIL_ASSERT_EXPR_OP_(greater, >)
+    BOOST_CONTRACT_DETAIL_ASSERT_EXPR_OP_(greater_equal, >=)
+
+    void fail() const {
+        std::ostringstream values;
+        print(values, left_);
+        site_.fail(values.str());
+    }
+
+private:
+    site const& site_;
+    typename boost::call_traits<L>::param_type left_;
+};
+
+#undef BOOST_CONTRACT_DETAIL_ASSERT_EXPR_OP_
+
+class decompose : public site {
+public:
+    decompose(char const* file, unsigned long line, char const* code) :
+            site(file, line, code) {}
+
+    template<typename L>
+    unary<L> operator<=(L const& left) const {
+        return unary<L>(*this, left);
+    }
+};
+
+} } } } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,45 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_BULK_HPP_
+#define BOOST_CONTRACT_DETAIL_BULK_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/config.hpp>
+
+namespace boost { namespace contract { namespace detail {
+
+// Bulk constructions and destructions of C in progress on this thread (so
+// contracts of each C ctor and dtor deferred to checks of entire batch).
+template<class C>
+class bulk {
+public:
+    #if     defined(BOOST_CONTRACT_DISABLE_THREADS) || \
+            !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+        static bool deferred() { return depth() > 0; }
+        static void defer() { ++depth(); }
+        static void resume() { --depth(); }
+
+    private:
+        static unsigned& depth() {
+            #ifndef BOOST_CONTRACT_DISABLE_THREADS
+                static thread_local unsigned n = 0;
+            #else
+                static unsigned n = 0;
+            #endif
+            return n;
+        }
+    #else // No thread-local so never deferred (batch checks still done).
+        static bool deferred() { return false; }
+        static void defer() {}
+        static void resume() {}
+    #endif
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -12,6 +12,7 @@
 #include <boost/contract/detail/declspec.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
 #include <boost/config.hpp>
 
 namespace boost { namespace contract { namespace detail {
@@ -22,13 +23,36 @@ namespace boost { namespace contract { namespace detail {
     #pragma warning(disable: 4251) // Member w/o DLL spec (mutex_ type).
 #endif
 
-// RAII facility to disable assertions while checking other assertions.
+// RAII facility to disable assertions while checking other assertions (up to
+// max nesting depth, also recording obj being checked, if any).
 class BOOST_CONTRACT_DETAIL_DECLSPEC checking :
     private boost::noncopyable // Non-copyable resource (might use mutex, etc.).
 {
+    BOOST_STATIC_ASSERT_MSG(BOOST_CONTRACT_MAX_CHECKING_DEPTH >= 1,
+            "max checking depth must be at least 1");
+
 public:
-    explicit checking() {
-        #ifndef BOOST_CONTRACT_DISABLE_THREADS
+    // For non-member and static member functions (no obj).
+    explicit checking() : obj_(0), id_(0), next_(0) {
+        #if     defined(BOOST_CONTRACT_THREAD_LOCAL_CHECKING) && \
+                !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            init_thread();
+        #elif !defined(BOOST_CONTRACT_DISABLE_THREADS)
+            init_locked();
+        #else
+            init_unlocked();
+        #endif
+    }
+
+    // Obj identified by both address and class (as first member, base, etc.
+    // can have same address).
+    template<class C>
+    explicit checking(C* obj) : obj_(obj), id_(&class_id_of<C>::value),
+            next_(0) {
+        #if     defined(BOOST_CONTRACT_THREAD_LOCAL_CHECKING) && \
+                !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            init_thread();
+        #elif !defined(BOOST_CONTRACT_DISABLE_THREADS)
             init_locked();
         #else
             init_unlocked();
@@ -36,7 +60,10 @@ public:
     }
 
     ~checking() {
-        #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        #if     defined(BOOST_CONTRACT_THREAD_LOCAL_CHECKING) && \
+                !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            done_thread();
+        #elif !defined(BOOST_CONTRACT_DISABLE_THREADS)
             done_locked();
         #else
             done_unlocked();
@@ -44,10 +71,26 @@ public:
     }
     
     static bool already() {
-        #ifndef BOOST_CONTRACT_DISABLE_THREADS
-            return already_locked();
+        #if     defined(BOOST_CONTRACT_THREAD_LOCAL_CHECKING) && \
+                !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            return depth_thread() >= BOOST_CONTRACT_MAX_CHECKING_DEPTH;
+        #elif !defined(BOOST_CONTRACT_DISABLE_THREADS)
+            return depth_locked() >= BOOST_CONTRACT_MAX_CHECKING_DEPTH;
         #else
-            return already_unlocked();
+            return depth_unlocked() >= BOOST_CONTRACT_MAX_CHECKING_DEPTH;
+        #endif
+    }
+
+    // True if contracts of obj already being checked (false if obj is 0).
+    template<class C>
+    static bool object(C* obj) {
+        #if     defined(BOOST_CONTRACT_THREAD_LOCAL_CHECKING) && \
+                !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            return object_thread(obj, &class_id_of<C>::value);
+        #elif !defined(BOOST_CONTRACT_DISABLE_THREADS)
+            return object_locked(obj, &class_id_of<C>::value);
+        #else
+            return object_unlocked(obj, &class_id_of<C>::value);
         #endif
     }
 
@@ -58,16 +101,58 @@ private:
     void done_unlocked();
     void done_locked();
 
-    static bool already_unlocked();
-    static bool already_locked();
+    static unsigned depth_unlocked();
+    static unsigned depth_locked();
+
+    typedef char const* class_id;
+
+    // Address of value identifies C (without cv). Not address of a function
+    // as linkers can fold identical ones (but not mutable data).
+    template<class C>
+    struct class_id_of { static char value; };
+
+    template<class C> struct class_id_of<C const> : class_id_of<C> {};
+    template<class C> struct class_id_of<C volatile> : class_id_of<C> {};
+    template<class C> struct class_id_of<C const volatile> : class_id_of<C> {};
+
+    static bool object_unlocked(void const volatile* obj, class_id id);
+    static bool object_locked(void const volatile* obj, class_id id);
+
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        // Use stack of calling thread (so no lock).
+        void init_thread();
+        void done_thread();
+        static unsigned depth_thread();
+        static bool object_thread(void const volatile* obj, class_id id);
+    #endif
 
     struct mutex_tag;
     typedef static_local_var<mutex_tag, boost::mutex> mutex;
 
-    struct checking_tag;
-    typedef static_local_var_init<checking_tag, bool, bool, false> flag;
+    struct stack { // POD so zero-initialized.
+        checking* top; // Guards linked from most recent.
+        unsigned depth;
+    };
+
+    void init(stack& s);
+    void done(stack& s);
+    static bool object_in(stack const& s, void const volatile* obj,
+            class_id id);
+
+    // Shared by all threads (so locked, unless threads disabled).
+    static stack& shared_stack();
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        static stack& thread_stack(); // Of calling thread.
+    #endif
+
+    void const volatile* obj_;
+    class_id id_;
+    checking* next_;
 };
 
+template<class C>
+char checking::class_id_of<C>::value = 0;
+
 #ifdef BOOST_MSVC
     #pragma warning(pop)
 #endif
@@ -18,11 +18,23 @@
 
 #include <boost/contract/core/exception.hpp>
 #include <boost/contract/core/config.hpp>
+#ifndef BOOST_CONTRACT_NO_CONDITIONS
+    #include <boost/contract/core/domain.hpp>
+    #ifdef BOOST_CONTRACT_PROFILING
+        #include <boost/contract/core/call_site.hpp>
+    #endif
+#endif
 #if     !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
         !defined(BOOST_CONTRACT_NO_OLDS) || \
         !defined(BOOST_CONTRACT_NO_EXEPTS)
     #include <boost/function.hpp>
 #endif
+#ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+    #include <boost/contract/core/memory.hpp>
+    #include <boost/function/function_base.hpp>
+    #include <new>
+    #include <cstddef>
+#endif
 #include <boost/noncopyable.hpp>
 #ifndef BOOST_CONTRACT_ON_MISSING_CHECK_DECL
     #include <boost/assert.hpp>
@@ -41,36 +53,93 @@ public:
         #ifndef BOOST_CONTRACT_NO_CONDITIONS
             , from_(from)
             , failed_(false)
+            , domain_(0)
+            #ifdef BOOST_CONTRACT_PROFILING
+                , site_(0)
+            #endif
+        #endif
+        #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+            , callables_(0)
         #endif
     {}
     
     // Can override for checking on exit, but should call assert_initialized().
     virtual ~cond_base() BOOST_NOEXCEPT_IF(false) {
+        #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+            account_memory(boost::contract::memory_::callables_kind,
+                    -callables_);
+        #endif
         // Catch error (but later) even if overrides miss assert_initialized().
         if(!init_asserted_) assert_initialized();
     }
 
+    #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+        // Count all condition objects (virtual dtor so size of derived type).
+        static void* operator new(std::size_t size) {
+            void* p = ::operator new(size);
+            account_memory(boost::contract::memory_::conditions_kind,
+                    std::ptrdiff_t(size));
+            return p;
+        }
+
+        static void operator delete(void* p, std::size_t size)
+                BOOST_NOEXCEPT_OR_NOTHROW {
+            account_memory(boost::contract::memory_::conditions_kind,
+                    -std::ptrdiff_t(size));
+            ::operator delete(p);
+        }
+    #endif
+
     void initialize() { // Must be called by owner ctor (i.e., check class).
         BOOST_CONTRACT_ERROR_missing_check_object_declaration = true;
         this->init(); // So all inits (pre, old, post) done after owner decl.
     }
+
+    // Skip all checks of this contract (as if an assertion already failed).
+    virtual void disable() {
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            failed(true);
+        #endif
+    }
+
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        void set_domain(boost::contract::domain const& d) { domain_ = &d; }
+
+        #ifdef BOOST_CONTRACT_PROFILING
+            // Site to count failures of (also used by owner to time exit).
+            void set_site(boost::contract::call_site const& s) { site_ = &s; }
+            boost::contract::call_site const* site() const { return site_; }
+        #endif
+    #endif
     
     #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
         template<typename F>
-        void set_pre(F const& f) { pre_ = f; }
+        void set_pre(F const& f) { account_callable<F>(); pre_ = f; }
     #endif
 
     #ifndef BOOST_CONTRACT_NO_OLDS
         template<typename F>
-        void set_old(F const& f) { old_ = f; }
+        void set_old(F const& f) { account_callable<F>(); old_ = f; }
     #endif
 
     #ifndef BOOST_CONTRACT_NO_EXCEPTS
         template<typename F>
-        void set_except(F const& f) { except_ = f; }
+        void set_except(F const& f) { account_callable<F>(); except_ = f; }
     #endif
 
 protected:
+    template<typename F>
+    void account_callable() { // Functors too large for Boost.Function buffer.
+        #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+            if(!boost::detail::function::
+                    function_allows_small_object_optimization<F>::value) {
+                callables_ += std::ptrdiff_t(sizeof(F));
+                account_memory(boost::contract::memory_::callables_kind,
+                        std::ptrdiff_t(sizeof(F)));
+            }
+        #endif
+    }
+
     void assert_initialized() { // Derived dtors must assert this at entry.
         init_asserted_ = true;
         #ifdef BOOST_CONTRACT_ON_MISSING_CHECK_DECL
@@ -120,7 +189,16 @@ protected:
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         void fail(void (*h)(boost::contract::from)) {
             failed(true);
-            if(h) h(from_);
+            #ifdef BOOST_CONTRACT_PROFILING
+                if(site_) site_->profile_failure();
+            #endif
+            if(!h) return;
+            if(domain_) { // Domain handlers called via scope (handlers rarely
+                // copied as only on failure).
+                boost::contract::scoped_failure_handlers scope;
+                domain_->scope_handlers(scope);
+                h(from_);
+            } else h(from_);
         }
     
         // Virtual so overriding pub func can use virtual_::failed_ instead.
@@ -134,6 +212,13 @@ private:
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         boost::contract::from from_;
         bool failed_;
+        boost::contract::domain const* domain_;
+        #ifdef BOOST_CONTRACT_PROFILING
+            boost::contract::call_site const* site_;
+        #endif
+    #endif
+    #ifdef BOOST_CONTRACT_MEMORY_ACCOUNTING
+        std::ptrdiff_t callables_;
     #endif
     // Following use Boost.Function to handle also lambdas, binds, etc.
     #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
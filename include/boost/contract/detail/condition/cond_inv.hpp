@@ -10,9 +10,15 @@
 #include <boost/contract/core/exception.hpp>
 #include <boost/contract/core/config.hpp>
 #include <boost/contract/detail/condition/cond_post.hpp>
+#include <boost/contract/contract_policy.hpp>
 #ifndef BOOST_CONTRACT_NO_INVARIANTS
     #include <boost/contract/core/access.hpp>
+    #include <boost/contract/invariant_policy.hpp>
+    #include <boost/contract/static_invariant_epoch.hpp>
+    #include <boost/contract/invariant_view.hpp>
     #include <boost/type_traits/add_pointer.hpp>
+    #include <boost/type_traits/remove_cv.hpp>
+    #include <boost/type_traits/is_const.hpp>
     #include <boost/type_traits/is_volatile.hpp>
     #include <boost/mpl/vector.hpp>
     #include <boost/mpl/transform.hpp>
@@ -23,11 +29,17 @@
     #include <boost/mpl/and.hpp>
     #include <boost/mpl/placeholders.hpp>
     #include <boost/utility/enable_if.hpp>
+    #include <boost/core/addressof.hpp>
     #ifndef BOOST_CONTRACT_PERMISSIVE
         #include <boost/function_types/property_tags.hpp>
         #include <boost/static_assert.hpp>
     #endif
 #endif
+#if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+        !defined(BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION) && \
+        BOOST_CONTRACT_MAX_CHECKING_DEPTH > 1
+    #include <boost/contract/detail/checking.hpp>
+#endif
 
 namespace boost { namespace contract { namespace detail {
 
@@ -99,19 +111,88 @@ public:
         #ifndef BOOST_CONTRACT_NO_CONDITIONS
             , obj_(obj)
         #endif
+        #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                !defined(BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION) && \
+                BOOST_CONTRACT_MAX_CHECKING_DEPTH > 1
+            // Nested in contracts of this same obj, so do not check its inv.
+            , nested_obj_(checking::object(obj))
+        #endif
     {}
     
 protected:
+    // Contract kinds not selected by class policy skipped (as not programmed).
+
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        bool check_pre(bool throw_on_failure = false) {
+            if(!contract_policy_checks<C, boost::contract::policy_preconditions
+                    >::value) return false;
+            return cond_post<VR>::check_pre(throw_on_failure);
+        }
+    #endif
+
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        void copy_old() { // Olds only used by post and except.
+            if(!contract_policy_checks<C,
+                boost::contract::policy_postconditions |
+                boost::contract::policy_excepts
+            >::value) return;
+            cond_post<VR>::copy_old();
+        }
+    #endif
+
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        template<typename Result>
+        void check_post(Result const& r) {
+            if(!contract_policy_checks<C, boost::contract::policy_postconditions
+                    >::value) return;
+            cond_post<VR>::check_post(r);
+        }
+    #endif
+
+    #ifndef BOOST_CONTRACT_NO_EXCEPTS
+        void check_except() {
+            if(!contract_policy_checks<C, boost::contract::policy_excepts
+                    >::value) return;
+            cond_post<VR>::check_except();
+        }
+    #endif
+
     #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
-        void check_entry_inv() { check_inv(true, false, false); }
-        void check_entry_static_inv() { check_inv(true, true, false); }
-        void check_entry_all_inv() { check_inv(true, false, true); }
+        void check_entry_inv() { check_entry_inv_of(obj_); }
+        void check_entry_static_inv() { check_inv(obj_, true, true, false); }
+        void check_entry_all_inv() { check_inv(obj_, true, false, true); }
+
+        // Also used to check invariants of bases directly on subcontracting.
+        template<class C_>
+        void check_entry_inv_of(C_* obj) { check_inv(obj, true, false, false); }
+
+        // Also used to check inv of many objs (static inv once per batch).
+        template<typename Iter>
+        void check_entry_all_inv_range(Iter first, Iter last) {
+            check_inv_range(first, last, true);
+        }
     #endif
     
     #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
-        void check_exit_inv() { check_inv(false, false, false); }
-        void check_exit_static_inv() { check_inv(false, true, false); }
-        void check_exit_all_inv() { check_inv(false, false, true); }
+        void check_exit_inv() { check_exit_inv_of(obj_); }
+        void check_exit_static_inv() { check_inv(obj_, false, true, false); }
+        void check_exit_all_inv() { check_inv(obj_, false, false, true); }
+
+        template<typename Iter>
+        void check_exit_all_inv_range(Iter first, Iter last) {
+            check_inv_range(first, last, false);
+        }
+
+        template<class C_>
+        void check_exit_inv_of(C_* obj) {
+            // Const (non-volatile) func cannot change obj, unless mutable.
+            check_inv(obj, false, boost::mpl::and_<
+                boost::is_const<C_>,
+                boost::mpl::not_<boost::is_volatile<C_> >,
+                boost::mpl::not_<boost::contract::check_const_exit_invariants<
+                        typename boost::remove_cv<C_>::type> >
+            >::value, false);
+        }
     #endif
 
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
@@ -120,48 +201,159 @@ protected:
 
 private:
     #ifndef BOOST_CONTRACT_NO_INVARIANTS
+        // Policy of class of inv (so also of bases when subcontracting).
+        // Constant once inlined (as on_entry constant at all call sites).
+        template<class C_>
+        static bool inv_policy_checks(bool on_entry) {
+            return on_entry ? contract_policy_checks<C_,
+                    boost::contract::policy_entry_invariants>::value :
+                    contract_policy_checks<C_,
+                    boost::contract::policy_exit_invariants>::value;
+        }
+
         // Static, cv, and const inv in that order as strongest qualifier first.
-        void check_inv(bool on_entry, bool static_only, bool const_and_cv) {
-            if(this->failed()) return;
+        template<class C_>
+        void check_inv(C_* obj, bool on_entry, bool static_only,
+                bool const_and_cv) {
+            if(!inv_policy_checks<C_>(on_entry) || this->failed()) return;
             try {
                 // Static members only check static inv.
-                check_static_inv<C>();
+                check_static_inv<C_>();
+                #if     !defined(BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION) && \
+                        BOOST_CONTRACT_MAX_CHECKING_DEPTH > 1
+                    if(nested_obj_) return;
+                #endif
                 if(!static_only) {
                     if(const_and_cv) {
-                        check_cv_inv<C>();
-                        check_const_inv<C>();
-                    } else if(boost::is_volatile<C>::value) {
-                        check_cv_inv<C>();
+                        check_viewed_inv(obj, true);
+                        // Record constructed obj (not destructed one at entry).
+                        if(!on_entry) const_inv_check(obj);
+                    } else if(boost::is_volatile<C_>::value) {
+                        check_cv_inv(obj);
+                    } else if(on_entry) {
+                        // Only exit records (it is after body changed obj).
+                        if(!const_inv_checked(obj)) {
+                            check_viewed_inv(obj, false);
+                        } // Else, obj not changed since exit inv checked.
                     } else {
-                        check_const_inv<C>();
+                        check_viewed_inv(obj, false);
+                        const_inv_check(obj); // Not thrown so record checked.
                     }
                 }
             } catch(...) {
                 if(on_entry) {
                     this->fail(&boost::contract::entry_invariant_failure);
-                } else this->fail(&boost::contract::exit_invariant_failure);
+                } else {
+                    // Entry record outdated (e.g., obj changed via mutable).
+                    if(obj) const_inv_uncheck(obj);
+                    this->fail(&boost::contract::exit_invariant_failure);
+                }
             }
         }
         
+        // Static inv once, then all inv of each obj in tight loop (no version
+        // records, no guards, etc. per obj so it can be vectorized).
+        template<typename Iter>
+        void check_inv_range(Iter first, Iter last, bool on_entry) {
+            if(!inv_policy_checks<C>(on_entry) || this->failed()) return;
+            try {
+                check_static_inv<C>();
+                for(; first != last; ++first) {
+                    check_viewed_inv(boost::addressof(*first), true);
+                }
+            } catch(...) {
+                if(on_entry) {
+                    this->fail(&boost::contract::entry_invariant_failure);
+                } else this->fail(&boost::contract::exit_invariant_failure);
+            }
+        }
+
+        // Volatile objs already concurrently accessed (so checked directly).
+        template<class C_>
+        typename boost::enable_if<boost::is_volatile<C_> >::type
+        check_viewed_inv(C_* obj, bool cv) {
+            if(cv) check_cv_inv(obj);
+            check_const_inv(obj);
+        }
+
+        // Checked again on new view while view not consistent (also if inv
+        // failed, as failures on inconsistent views are not reported).
+        template<class C_>
+        typename boost::disable_if<boost::is_volatile<C_> >::type
+        check_viewed_inv(C_* obj, bool cv) {
+            typedef boost::contract::invariant_view<
+                    typename boost::remove_cv<C_>::type> view_type;
+            for(;;) {
+                view_type view(*obj);
+                try {
+                    if(cv) check_cv_inv(boost::addressof(view.object()));
+                    check_const_inv(boost::addressof(view.object()));
+                } catch(...) {
+                    if(view.consistent()) throw;
+                    continue;
+                }
+                if(view.consistent()) return;
+            }
+        }
+
         template<class C_>
         typename boost::disable_if<
                 boost::contract::access::has_const_invariant<C_> >::type
-        check_const_inv() {}
+        check_const_inv(C_*) {}
         
         template<class C_>
         typename boost::enable_if<
                 boost::contract::access::has_const_invariant<C_> >::type
-        check_const_inv() { boost::contract::access::const_invariant(obj_); }
+        check_const_inv(C_* obj) {
+            boost::contract::access::const_invariant(obj);
+        }
         
+        template<class C_> // Volatile objects not versioned (always checked).
+        struct versioned_const_inv : boost::mpl::and_<
+            boost::contract::access::has_const_invariant<C_>,
+            boost::contract::access::has_invariant_version<C_>,
+            boost::mpl::not_<boost::is_volatile<C_> >
+        > {};
+
+        template<class C_>
+        typename boost::disable_if<versioned_const_inv<C_>, bool>::type
+        const_inv_checked(C_*) { return false; }
+
+        template<class C_>
+        typename boost::enable_if<versioned_const_inv<C_>, bool>::type
+        const_inv_checked(C_* obj) {
+            return boost::contract::access::invariant_checked(obj);
+        }
+
+        template<class C_>
+        typename boost::disable_if<versioned_const_inv<C_> >::type
+        const_inv_check(C_*) {}
+
+        template<class C_>
+        typename boost::enable_if<versioned_const_inv<C_> >::type
+        const_inv_check(C_* obj) {
+            boost::contract::access::invariant_check(obj);
+        }
+
+        template<class C_>
+        typename boost::disable_if<versioned_const_inv<C_> >::type
+        const_inv_uncheck(C_*) {}
+
+        template<class C_>
+        typename boost::enable_if<versioned_const_inv<C_> >::type
+        const_inv_uncheck(C_* obj) {
+            boost::contract::access::invariant_uncheck(obj);
+        }
+
         template<class C_>
         typename boost::disable_if<
                 boost::contract::access::has_cv_invariant<C_> >::type
-        check_cv_inv() {}
+        check_cv_inv(C_*) {}
 
         template<class C_>
         typename boost::enable_if<
                 boost::contract::access::has_cv_invariant<C_> >::type
-        check_cv_inv() { boost::contract::access::cv_invariant(obj_); }
+        check_cv_inv(C_* obj) { boost::contract::access::cv_invariant(obj); }
         
         template<class C_>
         typename boost::disable_if<
@@ -174,14 +366,20 @@ private:
         check_static_inv() {
             // SFINAE HAS_STATIC_... returns true even when member is inherited
             // so extra run-time check here (not the same for non static).
-            if(!inherited<boost::contract::access::has_static_invariant,
+            if(!inherited<C_, boost::contract::access::has_static_invariant,
                     boost::contract::access::static_invariant_addr>::apply()) {
+                typedef boost::contract::detail::static_invariant_cache<
+                        typename boost::remove_cv<C_>::type> cache;
+                unsigned long epoch;
+                if(cache::checked(epoch)) return; // Static state not changed.
                 boost::contract::access::static_invariant<C_>();
+                cache::check(epoch); // Not thrown so record checked.
             }
         }
 
         // Check if class's func is inherited from its base types or not.
-        template<template<class> class HasFunc, template<class> class FuncAddr>
+        template<class C_, template<class> class HasFunc,
+                template<class> class FuncAddr>
         struct inherited {
             static bool apply() {
                 try {
@@ -191,9 +389,9 @@ private:
                         typename boost::mpl::transform<
                             typename boost::mpl::copy_if<
                                 typename boost::mpl::eval_if<boost::contract::
-                                        access::has_base_types<C>,
+                                        access::has_base_types<C_>,
                                     typename boost::contract::access::
-                                            base_types_of<C>
+                                            base_types_of<C_>
                                 ,
                                     boost::mpl::vector<>
                                 >::type,
@@ -213,7 +411,7 @@ private:
                 template<typename B>
                 void operator()(B*) {
                     // Inherited func has same addr as in its base.
-                    if(FuncAddr<C>::apply() == FuncAddr<B>::apply()) {
+                    if(FuncAddr<C_>::apply() == FuncAddr<B>::apply()) {
                         throw signal_equal();
                     }
                 }
@@ -224,6 +422,11 @@ private:
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         C* obj_;
     #endif
+    #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+            !defined(BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION) && \
+            BOOST_CONTRACT_MAX_CHECKING_DEPTH > 1
+        bool nested_obj_;
+    #endif
 };
 
 } } } // namespace
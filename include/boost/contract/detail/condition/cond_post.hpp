@@ -26,7 +26,10 @@
         result_type, result_param, ftor_type, ftor_var, ftor_call) \
     public: \
         template<typename F> \
-        void set_post(F const& f) { ftor_var = f; } \
+        void set_post(F const& f) { \
+            this->template account_callable<F>(); \
+            ftor_var = f; \
+        } \
     \
     protected: \
         void check_post(result_type const& result_param) { \
@@ -47,6 +47,9 @@
         !defined(BOOST_CONTRACT_NO_EXCEPTS)
     #include <boost/mpl/for_each.hpp>
 #endif
+#ifndef BOOST_CONTRACT_NO_INVARIANTS
+    #include <boost/type_traits/copy_cv.hpp>
+#endif
 #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
     #include <boost/mpl/pop_front.hpp>
     #include <boost/mpl/front.hpp>
@@ -197,8 +200,12 @@ protected:
     
     #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
         void check_subcontracted_entry_inv() {
-            exec_and(boost::contract::virtual_::check_entry_inv,
-                    &cond_subcontracting::check_entry_inv);
+            if(base_call_) return; // Overriding func checked this inv already.
+            if(v_) {
+                boost::mpl::for_each<overridden_bases>(
+                        check_base_inv(*this, /* on_entry = */ true));
+            }
+            this->check_entry_inv();
         }
     #endif
     
@@ -221,8 +228,12 @@ protected:
 
     #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
         void check_subcontracted_exit_inv() {
-            exec_and(boost::contract::virtual_::check_exit_inv,
-                    &cond_subcontracting::check_exit_inv);
+            if(base_call_) return; // Overriding func checked this inv already.
+            if(v_) {
+                boost::mpl::for_each<overridden_bases>(
+                        check_base_inv(*this, /* on_entry = */ false));
+            }
+            this->check_exit_inv();
         }
     #endif
 
@@ -252,6 +263,12 @@ protected:
             if(v_) v_->failed_ = value;
             else cond_base::failed(value);
         }
+
+        // Base calls not disabled by their call sites (as v_ shared with the
+        // overriding function called by user).
+        void disable() /* override */ {
+            if(!base_call_) cond_base::disable();
+        }
     #endif
 
 private:
@@ -336,8 +353,7 @@ private:
         }
     #endif
 
-    #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) || \
-            !defined(BOOST_CONTRACT_NO_POSTCONDITIONS) || \
+    #if     !defined(BOOST_CONTRACT_NO_POSTCONDITIONS) || \
             !defined(BOOST_CONTRACT_NO_EXCEPTS)
         void exec_and( // Execute action in short-circuit logic-and with bases.
             boost::contract::virtual_::action_enum a,
@@ -416,6 +432,33 @@ private:
         }
     #endif
     
+    #ifndef BOOST_CONTRACT_NO_INVARIANTS
+        // Check base inv directly on obj (instead of calling base funcs, which
+        // would construct their conditions and throw to signal no error).
+        // Overridden bases unique so inv checked at most once per class.
+        class check_base_inv { // Copyable (as &).
+        public:
+            explicit check_base_inv(cond_subcontracting& me, bool on_entry) :
+                    me_(me), on_entry_(on_entry) {}
+
+            template<class B>
+            void operator()(B*) {
+                // Base inv checked with same cv qualifiers as this func.
+                typename boost::copy_cv<B, C>::type* obj = me_.object();
+                #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                    if(on_entry_) me_.check_entry_inv_of(obj);
+                #endif
+                #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                    if(!on_entry_) me_.check_exit_inv_of(obj);
+                #endif
+            }
+
+        private:
+            cond_subcontracting& me_;
+            bool on_entry_;
+        };
+    #endif
+
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         class call_base { // Copyable (as &).
         public:
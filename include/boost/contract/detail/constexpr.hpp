@@ -0,0 +1,59 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_CONSTEXPR_HPP_
+#define BOOST_CONTRACT_DETAIL_CONSTEXPR_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/detail/noop.hpp>
+#include <boost/preprocessor/stringize.hpp>
+#include <boost/config.hpp>
+
+// Use ternary operator `?:` and no trailing `;` here (same as DETAIL_ASSERT)
+// because used in C++11 constexpr functions (single return expression). Failure
+// branch calls non-constexpr function so failures are compiler errors during
+// constant evaluation (and branch not evaluated at all when cond holds).
+#define BOOST_CONTRACT_DETAIL_CONSTEXPR_ASSERT(failed, cond) \
+    /* no if-statement here */ \
+    ((cond) ? \
+        BOOST_CONTRACT_DETAIL_NOOP \
+    : \
+        boost::contract::detail::constexpr_::failed( \
+                __FILE__, __LINE__, BOOST_PP_STRINGIZE(cond)) \
+    ) /* no ; here */
+
+namespace boost { namespace contract { namespace detail {
+    namespace constexpr_ {
+
+// Not constexpr (on purpose, see above), and not inlined to keep constexpr
+// functions small when called at run-time.
+
+BOOST_NOINLINE inline void precondition_failed(char const* file,
+        unsigned long line, char const* code) {
+    try { throw boost::contract::assertion_failure(file, line, code); }
+    catch(...) {
+        boost::contract::precondition_failure(boost::contract::from_function);
+    }
+}
+
+BOOST_NOINLINE inline void postcondition_failed(char const* file,
+        unsigned long line, char const* code) {
+    try { throw boost::contract::assertion_failure(file, line, code); }
+    catch(...) {
+        boost::contract::postcondition_failure(boost::contract::from_function);
+    }
+}
+
+BOOST_NOINLINE inline void check_failed(char const* file, unsigned long line,
+        char const* code) {
+    try { throw boost::contract::assertion_failure(file, line, code); }
+    catch(...) { boost::contract::check_failure(); }
+}
+
+} } } } // namespace
+
+#endif // #include guard
+
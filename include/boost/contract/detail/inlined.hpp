@@ -7,9 +7,17 @@
 // file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
 // See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
 
+#include <boost/contract/detail/inlined/multiversion.hpp>
 #include <boost/contract/detail/inlined/old.hpp>
+#include <boost/contract/detail/inlined/static_invariant_epoch.hpp>
+#include <boost/contract/detail/inlined/core/call_site.hpp>
+#include <boost/contract/detail/inlined/core/domain.hpp>
 #include <boost/contract/detail/inlined/core/exception.hpp>
+#include <boost/contract/detail/inlined/core/failure_journal.hpp>
+#include <boost/contract/detail/inlined/core/failure_report.hpp>
+#include <boost/contract/detail/inlined/core/memory.hpp>
 #include <boost/contract/detail/inlined/detail/checking.hpp>
+#include <boost/contract/detail/inlined/detail/old_pool.hpp>
 
 #endif // #include guard
 
@@ -0,0 +1,301 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_CORE_CALL_SITE_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_CORE_CALL_SITE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/core/call_site.hpp>
+#include <boost/contract/detail/registry.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    #include <chrono>
+#else
+    #include <ctime>
+#endif
+#include <ostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cstddef>
+
+namespace boost { namespace contract { namespace call_site_ {
+
+// Either enabled or sampling period set by site (so both applied in order).
+struct setting {
+    setting(bool period, unsigned long v) : is_period(period), value(v) {}
+
+    bool is_period;
+    unsigned long value;
+};
+
+struct profile {
+    std::string name;
+    std::string file;
+    unsigned long line;
+    boost::uint64_t checks;
+    boost::uint64_t failures;
+    boost::uint64_t nanoseconds;
+};
+
+// True if file ends with suffix at a path separator (or is equal to it).
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool file_matches(char const* file, std::string const& suffix) {
+    if(!file) return false;
+    std::size_t const n = std::strlen(file);
+    if(suffix.empty() || suffix.size() > n) return false;
+    std::size_t const start = n - suffix.size();
+    if(suffix.compare(0, std::string::npos, file + start) != 0) return false;
+    return start == 0 || file[start - 1] == '/' || file[start - 1] == '\\';
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool matches(call_site const& s, std::string const& site) {
+    if(s.name() && site == s.name()) return true;
+    std::string::size_type const colon = site.rfind(':');
+    if(colon == std::string::npos || colon + 1 == site.size()) return false;
+    for(std::string::size_type i = colon + 1; i < site.size(); ++i) {
+        if(site[i] < '0' || site[i] > '9') return false;
+    }
+    return std::strtoul(site.c_str() + colon + 1, 0, 10) == s.line() &&
+            file_matches(s.file(), site.substr(0, colon));
+}
+
+// Tab-separated profile fields, so escape tabs (and new-lines, backslashes)
+// in names and files (empty if null).
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void write_escaped(std::ostream& out, char const* field) {
+    if(!field) return;
+    for(; *field != '\0'; ++field) {
+        switch(*field) {
+            case '\\': out << "\\\\"; break;
+            case '\t': out << "\\t"; break;
+            case '\n': out << "\\n"; break;
+            default: out << *field;
+        }
+    }
+}
+
+struct registry_traits { // Friend of call_site.
+    typedef call_site object_type;
+    typedef setting value_type;
+
+    static call_site*& next(call_site& s) { return s.next_; }
+
+    static bool matches(call_site const& s, std::string const& site) {
+        return call_site_::matches(s, site);
+    }
+
+    static void apply(call_site& s, setting const& v) {
+        if(v.is_period) sample(s, v.value);
+        else enable(s, v.value != 0);
+    }
+
+    static bool replaces(setting const& v, setting const& old) {
+        return v.is_period == old.is_period;
+    }
+
+    static void enable(call_site& s, bool enabled) {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            s.enabled_.store(enabled, std::memory_order_relaxed);
+        #else
+            s.enabled_ = enabled;
+        #endif
+    }
+
+    static void sample(call_site& s, unsigned long period) {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            s.period_.store(period, std::memory_order_relaxed);
+        #else
+            s.period_ = period;
+        #endif
+    }
+
+    // Copied under mutex (sites and their strings could be unloaded after).
+    static void profiles(call_site const* head, std::vector<profile>& all) {
+        for(call_site const* s = head; s; s = s->next_) {
+            profile p;
+            if(s->name()) p.name = s->name();
+            if(s->file()) p.file = s->file();
+            p.line = s->line();
+            #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+                p.checks = s->checks_.load(std::memory_order_relaxed);
+                p.failures = s->failures_.load(std::memory_order_relaxed);
+                p.nanoseconds = s->nanoseconds_.load(
+                        std::memory_order_relaxed);
+            #else // Already locked (so not via counted).
+                p.checks = s->checks_;
+                p.failures = s->failures_;
+                p.nanoseconds = s->nanoseconds_;
+            #endif
+            all.push_back(p);
+        }
+    }
+};
+
+typedef boost::contract::detail::registry<registry_traits> registry;
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void count(
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        std::atomic<boost::uint64_t>& counter,
+    #else
+        boost::uint64_t& counter,
+    #endif
+    boost::uint64_t value
+) {
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        counter.fetch_add(value, std::memory_order_relaxed);
+    #else
+        boost::lock_guard<boost::mutex> lock(registry::mutex());
+        counter += value;
+    #endif
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+boost::uint64_t counted(
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        std::atomic<boost::uint64_t> const& counter
+    #else
+        boost::uint64_t const& counter
+    #endif
+) {
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        return counter.load(std::memory_order_relaxed);
+    #else
+        boost::lock_guard<boost::mutex> lock(registry::mutex());
+        return counter;
+    #endif
+}
+
+// Sort profile by file, line, and name (so profiles of different runs diff).
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool profile_less(profile const& l, profile const& r) {
+    int const f = l.file.compare(r.file);
+    if(f != 0) return f < 0;
+    if(l.line != r.line) return l.line < r.line;
+    return l.name < r.name;
+}
+
+} // namespace
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+call_site::call_site(char const* name, char const* file, unsigned long line) :
+        name_(name), file_(file), line_(line), enabled_(true), period_(0),
+        samples_(0), checks_(0), failures_(0), nanoseconds_(0), next_(0) {
+    boost::lock_guard<boost::mutex> lock(call_site_::registry::mutex());
+    call_site_::registry::ref().add(*this);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+call_site::~call_site() {
+    boost::lock_guard<boost::mutex> lock(call_site_::registry::mutex());
+    call_site_::registry::ref().remove(*this);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+boost::uint64_t call_site::checks() const BOOST_NOEXCEPT_OR_NOTHROW {
+    return call_site_::counted(checks_);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+boost::uint64_t call_site::failures() const BOOST_NOEXCEPT_OR_NOTHROW {
+    return call_site_::counted(failures_);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+boost::uint64_t call_site::nanoseconds() const BOOST_NOEXCEPT_OR_NOTHROW {
+    return call_site_::counted(nanoseconds_);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+boost::uint64_t call_site::profile_now() BOOST_NOEXCEPT_OR_NOTHROW {
+    #ifndef BOOST_NO_CXX11_HDR_CHRONO
+        return static_cast<boost::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        );
+    #else
+        return static_cast<boost::uint64_t>(std::clock()) *
+                (1000000000u / CLOCKS_PER_SEC);
+    #endif
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void call_site::profile_check() const BOOST_NOEXCEPT_OR_NOTHROW {
+    call_site_::count(checks_, 1);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void call_site::profile_time(boost::uint64_t nanoseconds) const
+        BOOST_NOEXCEPT_OR_NOTHROW {
+    call_site_::count(nanoseconds_, nanoseconds);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void call_site::profile_failure() const BOOST_NOEXCEPT_OR_NOTHROW {
+    call_site_::count(failures_, 1);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool call_site::sampled_locked() const BOOST_NOEXCEPT_OR_NOTHROW {
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        return sampled();
+    #else
+        boost::lock_guard<boost::mutex> lock(call_site_::registry::mutex());
+        return period_ != 0 && samples_++ % period_ == 0;
+    #endif
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+std::size_t set_call_site_enabled(std::string const& site, bool enabled) {
+    boost::lock_guard<boost::mutex> lock(call_site_::registry::mutex());
+    return call_site_::registry::ref().set(site,
+            call_site_::setting(false, enabled));
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+std::size_t set_call_site_sampling(std::string const& site,
+        unsigned long period) {
+    boost::lock_guard<boost::mutex> lock(call_site_::registry::mutex());
+    return call_site_::registry::ref().set(site,
+            call_site_::setting(true, period));
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void write_call_site_profile(std::ostream& out) {
+    std::vector<call_site_::profile> profiles;
+    {
+        boost::lock_guard<boost::mutex> lock(call_site_::registry::mutex());
+        call_site_::registry_traits::profiles(
+                call_site_::registry::ref().head(), profiles);
+    } // Unlock (as out below might be slow).
+    std::sort(profiles.begin(), profiles.end(), &call_site_::profile_less);
+    out << "# Boost.Contract call site profile: name\tfile:line\tchecks\t" <<
+            "failures\tnanoseconds" << std::endl;
+    for(std::vector<call_site_::profile>::const_iterator p = profiles.begin();
+            p != profiles.end(); ++p) {
+        call_site_::write_escaped(out, p->name.c_str());
+        out << '\t';
+        call_site_::write_escaped(out, p->file.c_str());
+        out << ":" << p->line << '\t' << p->checks << '\t' << p->failures <<
+                '\t' << p->nanoseconds << std::endl;
+    }
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,122 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_CORE_DOMAIN_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_CORE_DOMAIN_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/core/domain.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/detail/registry.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/config.hpp>
+#include <string>
+#include <cstddef>
+
+namespace boost { namespace contract { namespace domain_ {
+
+struct registry_traits { // Friend of domain.
+    typedef domain object_type;
+    typedef domain_level value_type; // Levels set by name.
+
+    static domain*& next(domain& d) { return d.next_; }
+
+    static bool matches(domain const& d, std::string const& name) {
+        return d.name_ && name == d.name_;
+    }
+
+    static void apply(domain& d, domain_level level) {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            d.level_.store(level, std::memory_order_relaxed);
+        #else
+            d.level_ = level;
+        #endif
+    }
+
+    static bool replaces(domain_level, domain_level) { return true; }
+};
+
+typedef boost::contract::detail::registry<registry_traits> registry;
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void set_handler(from_failure_handler& h, from_failure_handler const& f) {
+    boost::lock_guard<boost::mutex> lock(registry::mutex());
+    h = f;
+}
+
+} // namespace
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+domain::domain(char const* name) : name_(name), level_(domain_on), next_(0) {
+    boost::lock_guard<boost::mutex> lock(domain_::registry::mutex());
+    domain_::registry::ref().add(*this);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+domain::~domain() {
+    boost::lock_guard<boost::mutex> lock(domain_::registry::mutex());
+    domain_::registry::ref().remove(*this);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void domain::set_level(domain_level level) BOOST_NOEXCEPT_OR_NOTHROW {
+    domain_::registry_traits::apply(*this, level);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+domain& domain::set_precondition_failure(from_failure_handler const& f) {
+    domain_::set_handler(pre_, f);
+    return *this;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+domain& domain::set_postcondition_failure(from_failure_handler const& f) {
+    domain_::set_handler(post_, f);
+    return *this;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+domain& domain::set_except_failure(from_failure_handler const& f) {
+    domain_::set_handler(except_, f);
+    return *this;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+domain& domain::set_old_failure(from_failure_handler const& f) {
+    domain_::set_handler(old_, f);
+    return *this;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+domain& domain::set_invariant_failure(from_failure_handler const& f) {
+    domain_::set_handler(inv_, f);
+    return *this;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void domain::scope_handlers(scoped_failure_handlers& scope) const {
+    boost::lock_guard<boost::mutex> lock(domain_::registry::mutex());
+    if(pre_) scope.set_precondition_failure(pre_);
+    if(post_) scope.set_postcondition_failure(post_);
+    if(except_) scope.set_except_failure(except_);
+    if(old_) scope.set_old_failure(old_);
+    if(inv_) scope.set_invariant_failure(inv_);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+std::size_t set_domain_level(std::string const& name, domain_level level) {
+    boost::lock_guard<boost::mutex> lock(domain_::registry::mutex());
+    return domain_::registry::ref().set(name, level);
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -11,21 +11,190 @@
 // .cpp does not need recompiling if config changes (recompile only user code).
 
 #include <boost/contract/core/exception.hpp>
+#include <boost/contract/core/failure_journal.hpp>
 #include <boost/contract/detail/static_local_var.hpp>
 #include <boost/contract/detail/declspec.hpp>
 #include <boost/thread/lock_guard.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    #include <atomic>
+#endif
+#if defined(__linux__) && defined(__GNUC__) // Also Clang.
+    #include <unwind.h>
+    #include <execinfo.h>
+    #include <cstdlib>
+#endif
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <exception>
+#include <algorithm>
+#include <new>
+#include <cstddef>
 
 namespace boost { namespace contract {
 
+namespace exception_ {
+    // Stack capture.
+
+    struct stack_capture_mutex_tag;
+    typedef boost::contract::detail::static_local_var<stack_capture_mutex_tag,
+            boost::mutex> stack_capture_mutex;
+
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        struct stack_capture_tag;
+        typedef boost::contract::detail::static_local_var<stack_capture_tag,
+                std::atomic<bool> > stack_capture; // Zero-init (as static).
+
+        BOOST_CONTRACT_DETAIL_DECLINLINE
+        bool capturing() BOOST_NOEXCEPT_OR_NOTHROW {
+            return stack_capture::ref().load(std::memory_order_relaxed);
+        }
+
+        BOOST_CONTRACT_DETAIL_DECLINLINE
+        void capturing(bool capture) BOOST_NOEXCEPT_OR_NOTHROW {
+            stack_capture::ref().store(capture, std::memory_order_relaxed);
+        }
+    #else
+        struct stack_capture_tag;
+        typedef boost::contract::detail::static_local_var<stack_capture_tag,
+                bool> stack_capture; // Zero-init (as static).
+
+        BOOST_CONTRACT_DETAIL_DECLINLINE
+        bool capturing() BOOST_NOEXCEPT_OR_NOTHROW {
+            boost::lock_guard<boost::mutex> lock(stack_capture_mutex::ref());
+            return stack_capture::ref();
+        }
+
+        BOOST_CONTRACT_DETAIL_DECLINLINE
+        void capturing(bool capture) BOOST_NOEXCEPT_OR_NOTHROW {
+            boost::lock_guard<boost::mutex> lock(stack_capture_mutex::ref());
+            stack_capture::ref() = capture;
+        }
+    #endif
+
+    #if defined(__linux__) && defined(__GNUC__)
+        struct frames {
+            void** first;
+            std::size_t size;
+            std::size_t max_size;
+            std::size_t skip;
+        };
+
+        BOOST_CONTRACT_DETAIL_DECLINLINE
+        _Unwind_Reason_Code unwind_frame(_Unwind_Context* context, void* data) {
+            frames& f = *static_cast<frames*>(data);
+            if(f.skip > 0) {
+                --f.skip;
+                return _URC_NO_REASON;
+            }
+            _Unwind_Ptr const ip = _Unwind_GetIP(context);
+            if(ip == 0 || f.size >= f.max_size) return _URC_END_OF_STACK;
+            f.first[f.size++] = reinterpret_cast<void*>(ip);
+            return _URC_NO_REASON;
+        }
+    #endif
+
+    // Return number of return addresses captured (skipping this function).
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    std::size_t capture(void** first, std::size_t max_size)
+            BOOST_NOEXCEPT_OR_NOTHROW {
+        #if defined(__linux__) && defined(__GNUC__)
+            frames f = {first, 0, max_size, 1};
+            _Unwind_Backtrace(&unwind_frame, &f);
+            return f.size;
+        #else // No unwinder.
+            return 0;
+        #endif
+    }
+}
+
 BOOST_CONTRACT_DETAIL_DECLINLINE
-exception::~exception() BOOST_NOEXCEPT_OR_NOTHROW {}
+exception::exception() BOOST_NOEXCEPT_OR_NOTHROW : stack_(0), stack_size_(0) {
+    if(exception_::capturing()) {
+        void* stack[32]; // Captured on stack, then stored only what is needed.
+        std::size_t const size = exception_::capture(stack,
+                sizeof stack / sizeof stack[0]);
+        if(size > 0) {
+            stack_ = new(std::nothrow) void*[size];
+            if(stack_) {
+                std::copy(stack, stack + size, stack_);
+                stack_size_ = size;
+            }
+        }
+    }
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+exception::exception(exception const& other) BOOST_NOEXCEPT_OR_NOTHROW :
+        stack_(0), stack_size_(0) {
+    copy_stack(other);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+exception& exception::operator=(exception const& other)
+        BOOST_NOEXCEPT_OR_NOTHROW {
+    if(this != &other) {
+        delete[] stack_;
+        stack_ = 0;
+        stack_size_ = 0;
+        copy_stack(other);
+    }
+    return *this;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+exception::~exception() BOOST_NOEXCEPT_OR_NOTHROW { delete[] stack_; }
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void exception::copy_stack(exception const& other) BOOST_NOEXCEPT_OR_NOTHROW {
+    if(other.stack_size_ == 0) return;
+    stack_ = new(std::nothrow) void*[other.stack_size_];
+    if(!stack_) return; // Copy without stack (as if not captured).
+    std::copy(other.stack_, other.stack_ + other.stack_size_, stack_);
+    stack_size_ = other.stack_size_;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void* const* exception::stack() const { return stack_; }
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+std::size_t exception::stack_size() const { return stack_size_; }
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void set_stack_capture(bool capture) BOOST_NOEXCEPT_OR_NOTHROW {
+    exception_::capturing(capture);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool get_stack_capture() BOOST_NOEXCEPT_OR_NOTHROW {
+    return exception_::capturing();
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+std::string symbolize_stack(void* const* stack, std::size_t size) {
+    std::ostringstream text;
+    #if defined(__linux__) && defined(__GNUC__)
+        char** symbols = size == 0 ? 0 : backtrace_symbols(stack,
+                static_cast<int>(size));
+    #endif
+    for(std::size_t i = 0; i < size; ++i) {
+        text << "#" << i << " ";
+        #if defined(__linux__) && defined(__GNUC__)
+            if(symbols) { // Format: module(function+offset) [address].
+                text << symbols[i] << std::endl;
+                continue;
+            }
+        #endif
+        text << "[" << stack[i] << "]" << std::endl;
+    }
+    #if defined(__linux__) && defined(__GNUC__)
+        std::free(symbols);
+    #endif
+    return text.str();
+}
 
 BOOST_CONTRACT_DETAIL_DECLINLINE
 bad_virtual_result_cast::bad_virtual_result_cast(char const* from_type_name,
@@ -58,6 +227,13 @@ assertion_failure::assertion_failure(char const* const code) :
     file_(""), line_(0), code_(code)
 { init(); }
 
+BOOST_CONTRACT_DETAIL_DECLINLINE
+assertion_failure::assertion_failure(char const* const file,
+        unsigned long const line, char const* const code,
+        std::string const& values) :
+    file_(file), line_(line), code_(code), values_(values)
+{ init(); }
+
 BOOST_CONTRACT_DETAIL_DECLINLINE
 assertion_failure::~assertion_failure() BOOST_NOEXCEPT_OR_NOTHROW {}
 
@@ -75,12 +251,16 @@ unsigned long assertion_failure::line() const { return line_; }
 BOOST_CONTRACT_DETAIL_DECLINLINE
 char const* assertion_failure::code() const { return code_; }
 
+BOOST_CONTRACT_DETAIL_DECLINLINE
+char const* assertion_failure::values() const { return values_.c_str(); }
+
 BOOST_CONTRACT_DETAIL_DECLINLINE
 void assertion_failure::init() {
     std::ostringstream text;
     text << "assertion";
     if(std::string(code_) != "") text << " \"" << code_ << "\"";
     text << " failed";
+    if(values_ != "") text << " for \"" << values_ << "\"";
     if(std::string(file_) != "") {
         text << ": file \"" << file_ << "\"";
         if(line_ != 0) text << ", line " << line_;
@@ -115,7 +295,8 @@ namespace exception_ {
         try { throw; }
         catch(boost::contract::assertion_failure const& error) {
             // what = "assertion '...' failed: ...".
-            std::cerr << k << error.what() << std::endl;
+            std::cerr << k << error.what() << std::endl << symbolize_stack(
+                    error.stack(), error.stack_size());
         } catch(...) { // old_failure_key prints this, not above.
             std::cerr << k << "threw following exception:" << std::endl
                     << boost::current_exception_diagnostic_information();
@@ -126,6 +307,85 @@ namespace exception_ {
     template<failure_key Key>
     void default_from_handler(from) { default_handler<Key>(); }
 
+    // Scoped failure handlers.
+
+    struct unlocked_scope_tag;
+    typedef boost::contract::detail::static_local_var<unlocked_scope_tag,
+            scoped_failure_handlers*> unlocked_scope; // Zero-initialized.
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    scoped_failure_handlers*& scope_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
+        return unlocked_scope::ref();
+    }
+
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        BOOST_CONTRACT_DETAIL_DECLINLINE
+        scoped_failure_handlers*& scope_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+            static thread_local scoped_failure_handlers* top = 0;
+            return top;
+        }
+    #endif
+
+    class scopes {
+    public:
+        // Call handler of innermost scope that set it (return false if none).
+        static bool call(scoped_failure_handlers*& top) {
+            for(scoped_failure_handlers* s = top; s; s = s->prev_) {
+                if(s->check_) {
+                    outer o(top, s->prev_);
+                    s->check_();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static bool call(scoped_failure_handlers*& top, failure_key key,
+                from where) {
+            for(scoped_failure_handlers* s = top; s; s = s->prev_) {
+                from_failure_handler const& h = handler(s, key);
+                if(h) {
+                    outer o(top, s->prev_);
+                    h(where);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        // Handler called in its outer scope (so it can delegate to it).
+        class outer {
+        public:
+            outer(scoped_failure_handlers*& top, scoped_failure_handlers* s) :
+                    top_(top), inner_(top) { top_ = s; }
+            ~outer() { top_ = inner_; }
+
+        private:
+            scoped_failure_handlers*& top_;
+            scoped_failure_handlers* inner_;
+        };
+
+        static from_failure_handler const& handler(
+                scoped_failure_handlers const* s, failure_key key) {
+            switch(key) {
+                case pre_failure_key: return s->pre_;
+                case post_failure_key: return s->post_;
+                case except_failure_key: return s->except_;
+                case old_failure_key: return s->old_;
+                case entry_inv_failure_key: return s->entry_inv_;
+                case exit_inv_failure_key: return s->exit_inv_;
+                case check_failure_key: break; // Not a from handler.
+            }
+            return none();
+        }
+
+        static from_failure_handler const& none() {
+            static from_failure_handler const h;
+            return h;
+        }
+    };
+
     // Check failure.
 
     struct check_failure_mutex_tag;
@@ -167,13 +427,19 @@ namespace exception_ {
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void check_failure_unlocked() /* can throw */ {
+        failure_journal_::record(failed_check, from_function);
+        if(scopes::call(scope_unlocked())) return;
         check_failure_handler::ref()();
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void check_failure_locked() /* can throw */ {
+        failure_journal_::record(failed_check, from_function);
+        #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+            if(scopes::call(scope_locked())) return;
+        #endif
         boost::lock_guard<boost::mutex> lock(check_failure_mutex::ref());
-        check_failure_unlocked();
+        check_failure_handler::ref()();
     }
     
     // Precondition failure.
@@ -217,13 +483,19 @@ namespace exception_ {
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void pre_failure_unlocked(from where) /* can throw */ {
+        failure_journal_::record(failed_precondition, where);
+        if(scopes::call(scope_unlocked(), pre_failure_key, where)) return;
         pre_failure_handler::ref()(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void pre_failure_locked(from where) /* can throw */ {
+        failure_journal_::record(failed_precondition, where);
+        #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+            if(scopes::call(scope_locked(), pre_failure_key, where)) return;
+        #endif
         boost::lock_guard<boost::mutex> lock(pre_failure_mutex::ref());
-        pre_failure_unlocked(where);
+        pre_failure_handler::ref()(where);
     }
     
     // Postcondition failure.
@@ -267,13 +539,19 @@ namespace exception_ {
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void post_failure_unlocked(from where) /* can throw */ {
+        failure_journal_::record(failed_postcondition, where);
+        if(scopes::call(scope_unlocked(), post_failure_key, where)) return;
         post_failure_handler::ref()(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void post_failure_locked(from where) /* can throw */ {
+        failure_journal_::record(failed_postcondition, where);
+        #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+            if(scopes::call(scope_locked(), post_failure_key, where)) return;
+        #endif
         boost::lock_guard<boost::mutex> lock(post_failure_mutex::ref());
-        post_failure_unlocked(where);
+        post_failure_handler::ref()(where);
     }
     
     // Except failure.
@@ -318,13 +596,19 @@ namespace exception_ {
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void except_failure_unlocked(from where) /* can throw */ {
+        failure_journal_::record(failed_except, where);
+        if(scopes::call(scope_unlocked(), except_failure_key, where)) return;
         except_failure_handler::ref()(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void except_failure_locked(from where) /* can throw */ {
+        failure_journal_::record(failed_except, where);
+        #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+            if(scopes::call(scope_locked(), except_failure_key, where)) return;
+        #endif
         boost::lock_guard<boost::mutex> lock(except_failure_mutex::ref());
-        except_failure_unlocked(where);
+        except_failure_handler::ref()(where);
     }
 
     // Old-copy failure.
@@ -368,13 +652,19 @@ namespace exception_ {
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void old_failure_unlocked(from where) /* can throw */ {
+        failure_journal_::record(failed_old, where);
+        if(scopes::call(scope_unlocked(), old_failure_key, where)) return;
         old_failure_handler::ref()(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void old_failure_locked(from where) /* can throw */ {
+        failure_journal_::record(failed_old, where);
+        #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+            if(scopes::call(scope_locked(), old_failure_key, where)) return;
+        #endif
         boost::lock_guard<boost::mutex> lock(old_failure_mutex::ref());
-        old_failure_unlocked(where);
+        old_failure_handler::ref()(where);
     }
     
     // Entry invariant failure.
@@ -420,13 +710,20 @@ namespace exception_ {
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void entry_inv_failure_unlocked(from where) /* can throw */ {
+        failure_journal_::record(failed_entry_invariant, where);
+        if(scopes::call(scope_unlocked(), entry_inv_failure_key, where)) return;
         entry_inv_failure_handler::ref()(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void entry_inv_failure_locked(from where) /* can throw */ {
+        failure_journal_::record(failed_entry_invariant, where);
+        #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+            if(scopes::call(scope_locked(), entry_inv_failure_key,
+                    where)) return;
+        #endif
         boost::lock_guard<boost::mutex> lock(entry_inv_failure_mutex::ref());
-        entry_inv_failure_unlocked(where);
+        entry_inv_failure_handler::ref()(where);
     }
     
     // Exit invariant failure.
@@ -472,13 +769,20 @@ namespace exception_ {
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void exit_inv_failure_unlocked(from where) /* can throw */ {
+        failure_journal_::record(failed_exit_invariant, where);
+        if(scopes::call(scope_unlocked(), exit_inv_failure_key, where)) return;
         exit_inv_failure_handler::ref()(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void exit_inv_failure_locked(from where) /* can throw */ {
+        failure_journal_::record(failed_exit_invariant, where);
+        #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+            if(scopes::call(scope_locked(), exit_inv_failure_key,
+                    where)) return;
+        #endif
         boost::lock_guard<boost::mutex> lock(exit_inv_failure_mutex::ref());
-        exit_inv_failure_unlocked(where);
+        exit_inv_failure_handler::ref()(where);
     }
 }
 
@@ -0,0 +1,377 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_CORE_FAILURE_JOURNAL_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_CORE_FAILURE_JOURNAL_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/core/failure_journal.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    #include <atomic>
+#endif
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    #include <chrono>
+#endif
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+    #include <thread>
+    #include <functional>
+#endif
+#ifdef BOOST_HAS_UNISTD_H
+    #include <sys/mman.h>
+    #include <sys/types.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+#include <vector>
+#include <exception>
+#include <new>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+
+namespace boost { namespace contract { namespace failure_journal_ {
+
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    typedef std::atomic<boost::uint64_t> counter;
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::uint64_t load(counter const& c) BOOST_NOEXCEPT_OR_NOTHROW {
+        return c.load(std::memory_order_acquire);
+    }
+#else // Counters locked by mutex below instead.
+    typedef boost::uint64_t counter;
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::uint64_t load(counter const& c) BOOST_NOEXCEPT_OR_NOTHROW {
+        return c;
+    }
+#endif
+
+// Layout of both rings in memory and journal files.
+
+char const magic[8] = {'b', 'c', 'f', 'j', 'r', 'n', 'l', '1'};
+
+struct header {
+    char magic[8];
+    boost::uint64_t capacity;
+    boost::uint64_t event_size; // To reject files from other platforms.
+    counter next; // Ticket of next event.
+};
+
+struct slot {
+    counter seq; // Ticket + 1 of event in slot (0 if none, busy if writing).
+    failure_event event;
+};
+
+boost::uint64_t const busy = ~boost::uint64_t(0); // Never ticket + 1 read.
+
+class ring {
+public:
+    ring() : head_(0), slots_(0), data_(0), size_(0), mapped_(false) {}
+
+    ~ring() {
+        #ifdef BOOST_HAS_UNISTD_H
+            if(mapped_) { ::munmap(data_, size_); return; }
+        #endif
+        std::free(data_);
+    }
+
+    static std::size_t size(std::size_t capacity) {
+        return sizeof(header) + capacity * sizeof(slot);
+    }
+
+    bool allocate(std::size_t capacity) {
+        size_ = size(capacity);
+        data_ = std::calloc(1, size_);
+        return init(capacity);
+    }
+
+    bool map(std::size_t capacity, char const* path) {
+        #ifdef BOOST_HAS_UNISTD_H
+            size_ = size(capacity);
+            int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if(fd < 0) return false;
+            if(::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+                ::close(fd);
+                return false;
+            }
+            void* data = ::mmap(0, size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    fd, 0);
+            ::close(fd); // Mapping kept after closing.
+            if(data == MAP_FAILED) return false;
+            data_ = data;
+            mapped_ = true;
+            return init(capacity);
+        #else
+            return false;
+        #endif
+    }
+
+    header* head() const { return head_; }
+    slot* slots() const { return slots_; }
+
+private:
+    // Data zeroed (by calloc and ftruncate) so only construct objects here.
+    bool init(std::size_t capacity) {
+        if(!data_) return false;
+        head_ = new(data_) header();
+        std::memcpy(head_->magic, magic, sizeof magic);
+        head_->capacity = capacity;
+        head_->event_size = sizeof(failure_event);
+        slots_ = reinterpret_cast<slot*>(head_ + 1);
+        for(std::size_t i = 0; i < capacity; ++i) new(slots_ + i) slot();
+        return true;
+    }
+
+    ring(ring const&);
+    ring& operator=(ring const&);
+
+    header* head_;
+    slot* slots_;
+    void* data_;
+    std::size_t size_;
+    bool mapped_;
+};
+
+struct mutex_tag;
+typedef boost::contract::detail::static_local_var<mutex_tag, boost::mutex>
+        mutex;
+
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    struct current_tag;
+    typedef boost::contract::detail::static_local_var<current_tag,
+            std::atomic<ring*> > current_ring; // Zero-initialized (as static).
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    ring* current() BOOST_NOEXCEPT_OR_NOTHROW {
+        return current_ring::ref().load(std::memory_order_acquire);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void current(ring* r) BOOST_NOEXCEPT_OR_NOTHROW {
+        current_ring::ref().store(r, std::memory_order_release);
+    }
+#else
+    struct current_tag;
+    typedef boost::contract::detail::static_local_var<current_tag, ring*>
+            current_ring;
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    ring* current() BOOST_NOEXCEPT_OR_NOTHROW {
+        boost::lock_guard<boost::mutex> lock(mutex::ref());
+        return current_ring::ref();
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void current(ring* r) BOOST_NOEXCEPT_OR_NOTHROW {
+        boost::lock_guard<boost::mutex> lock(mutex::ref());
+        current_ring::ref() = r;
+    }
+#endif
+
+// Rings released only at exit (failures might be recording to them).
+class rings {
+public:
+    // Construct current ring var first so it is destructed after this.
+    rings() { current_ring::ref(); } // No lock (as mutex held by start).
+
+    ~rings() {
+        current(0); // So failures at exit no longer record to rings.
+        for(std::size_t i = 0; i < all_.size(); ++i) delete all_[i];
+    }
+
+    void add(ring* r) { all_.push_back(r); }
+
+private:
+    std::vector<ring*> all_;
+};
+
+struct rings_tag;
+typedef boost::contract::detail::static_local_var<rings_tag, rings>
+        all_rings;
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void copy(char* to, std::size_t size, char const* from)
+        BOOST_NOEXCEPT_OR_NOTHROW {
+    std::size_t i = 0;
+    if(from) for(; i < size - 1 && from[i] != '\0'; ++i) to[i] = from[i];
+    to[i] = '\0';
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void describe(failure_event& e) BOOST_NOEXCEPT_OR_NOTHROW {
+    #ifndef BOOST_NO_CXX11_HDR_EXCEPTION
+        if(!std::current_exception()) return; // Not called from catch block.
+    #endif
+    try { throw; }
+    catch(boost::contract::assertion_failure const& error) {
+        copy(e.file, sizeof e.file, error.file());
+        e.line = error.line();
+        copy(e.code, sizeof e.code, error.code());
+    } catch(std::exception const& error) {
+        copy(e.code, sizeof e.code, error.what());
+    } catch(...) {}
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void record(failure_kind kind, from where) BOOST_NOEXCEPT_OR_NOTHROW {
+    ring* r = current();
+    if(!r) return;
+
+    failure_event e; // Filled before claiming slot (to keep slot busy less).
+    e.kind = kind;
+    e.where = where;
+    #ifndef BOOST_NO_CXX11_HDR_CHRONO
+        e.timestamp = static_cast<boost::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()
+            ).count()
+        );
+    #else
+        e.timestamp = static_cast<boost::uint64_t>(std::time(0)) *
+                1000000000u;
+    #endif
+    #ifndef BOOST_NO_CXX11_HDR_THREAD
+        e.thread = static_cast<boost::uint64_t>(
+                std::hash<std::thread::id>()(std::this_thread::get_id()));
+    #else
+        e.thread = 0;
+    #endif
+    e.line = 0;
+    e.file[0] = e.code[0] = '\0';
+    describe(e);
+
+    header& h = *r->head();
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        boost::uint64_t const ticket = h.next.fetch_add(1,
+                std::memory_order_relaxed);
+        slot& s = r->slots()[ticket % h.capacity];
+        // Claim slot so writers wrapping around to same slot do not mix up
+        // events (drop this event if slot is being written or has newer one).
+        // Acquire so previous write of slot event happens before this one.
+        boost::uint64_t seq = s.seq.load(std::memory_order_relaxed);
+        if(seq == busy || seq > ticket || !s.seq.compare_exchange_strong(seq,
+                busy, std::memory_order_acquire)) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&s.event, &e, sizeof e);
+        s.seq.store(ticket + 1, std::memory_order_release);
+    #else
+        boost::lock_guard<boost::mutex> lock(mutex::ref());
+        boost::uint64_t const ticket = h.next++;
+        slot& s = r->slots()[ticket % h.capacity];
+        std::memcpy(&s.event, &e, sizeof e);
+        s.seq = ticket + 1;
+    #endif
+}
+
+// Skip slots being written (or overwritten) while reading them.
+BOOST_CONTRACT_DETAIL_DECLINLINE
+std::vector<failure_event> events(header const& h, slot const* slots) {
+    std::vector<failure_event> v;
+    boost::uint64_t const next = load(h.next);
+    boost::uint64_t ticket = next > h.capacity ? next - h.capacity : 0;
+    for(; ticket < next; ++ticket) {
+        slot const& s = slots[ticket % h.capacity];
+        if(load(s.seq) != ticket + 1) continue;
+        failure_event e;
+        std::memcpy(&e, &s.event, sizeof e);
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            std::atomic_thread_fence(std::memory_order_acquire);
+        #endif
+        if(load(s.seq) != ticket + 1) continue;
+        v.push_back(e);
+    }
+    return v;
+}
+
+} // namespace
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool start_failure_journal(std::size_t capacity, char const* path)
+        BOOST_NOEXCEPT_OR_NOTHROW {
+    if(capacity == 0) return false;
+    failure_journal_::ring* r = 0;
+    try {
+        boost::lock_guard<boost::mutex> lock(failure_journal_::mutex::ref());
+        r = new failure_journal_::ring();
+        failure_journal_::all_rings::ref().add(r);
+    } catch(...) {
+        delete r;
+        return false;
+    }
+    if(path ? !r->map(capacity, path) : !r->allocate(capacity)) return false;
+    failure_journal_::current(r);
+    return true;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void stop_failure_journal() BOOST_NOEXCEPT_OR_NOTHROW {
+    failure_journal_::current(0);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+std::vector<failure_event> failure_journal_events() {
+    failure_journal_::ring* r = failure_journal_::current();
+    if(!r) return std::vector<failure_event>();
+    #ifdef BOOST_NO_CXX11_HDR_ATOMIC
+        boost::lock_guard<boost::mutex> lock(failure_journal_::mutex::ref());
+    #endif
+    return failure_journal_::events(*r->head(), r->slots());
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+std::vector<failure_event> read_failure_journal(char const* path) {
+    std::vector<failure_event> v;
+    std::FILE* f = std::fopen(path, "rb");
+    if(!f) return v;
+    std::vector<char> data;
+    char buffer[4096];
+    for(std::size_t n; (n = std::fread(buffer, 1, sizeof buffer, f)) > 0;) {
+        data.insert(data.end(), buffer, buffer + n);
+    }
+    std::fclose(f);
+    if(data.size() < sizeof(failure_journal_::header)) return v;
+
+    // Copy to raw memory aligned for any type (as ring data allocated by
+    // allocate above, while data of vector<char> might not be aligned).
+    void* aligned = std::malloc(data.size());
+    if(!aligned) return v;
+    std::memcpy(aligned, &data[0], data.size());
+    failure_journal_::header const& h =
+            *static_cast<failure_journal_::header const*>(aligned);
+    try {
+        if(std::memcmp(h.magic, failure_journal_::magic,
+                sizeof failure_journal_::magic) == 0 &&
+                h.event_size == sizeof(failure_event) && h.capacity > 0 &&
+                data.size() >= failure_journal_::ring::size(h.capacity)) {
+            v = failure_journal_::events(h,
+                    reinterpret_cast<failure_journal_::slot const*>(&h + 1));
+        }
+    } catch(...) {
+        std::free(aligned);
+        throw;
+    }
+    std::free(aligned);
+    return v;
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,231 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_CORE_FAILURE_REPORT_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_CORE_FAILURE_REPORT_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/core/failure_report.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    #include <atomic>
+#endif
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    #include <chrono>
+#endif
+#include <exception>
+#include <typeinfo>
+#include <ctime>
+
+namespace boost { namespace contract { namespace failure_report_ {
+
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    typedef std::atomic<boost::uint64_t> counter;
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::uint64_t load(counter const& c) BOOST_NOEXCEPT_OR_NOTHROW {
+        return c.load(std::memory_order_acquire);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void store(counter& c, boost::uint64_t v) BOOST_NOEXCEPT_OR_NOTHROW {
+        c.store(v, std::memory_order_release);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    bool compare_exchange(counter& c, boost::uint64_t& expected,
+            boost::uint64_t v) BOOST_NOEXCEPT_OR_NOTHROW {
+        return c.compare_exchange_strong(expected, v,
+                std::memory_order_acq_rel, std::memory_order_acquire);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::uint64_t take(counter& c) BOOST_NOEXCEPT_OR_NOTHROW { // Reset to 0.
+        return c.exchange(0, std::memory_order_acq_rel);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void increment(counter& c) BOOST_NOEXCEPT_OR_NOTHROW {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+#else // Counters locked by mutex below instead.
+    typedef boost::uint64_t counter;
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::uint64_t load(counter const& c) BOOST_NOEXCEPT_OR_NOTHROW {
+        return c;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void store(counter& c, boost::uint64_t v) BOOST_NOEXCEPT_OR_NOTHROW {
+        c = v;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    bool compare_exchange(counter& c, boost::uint64_t& expected,
+            boost::uint64_t v) BOOST_NOEXCEPT_OR_NOTHROW {
+        if(c != expected) {
+            expected = c;
+            return false;
+        }
+        c = v;
+        return true;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::uint64_t take(counter& c) BOOST_NOEXCEPT_OR_NOTHROW {
+        boost::uint64_t const old = c;
+        c = 0;
+        return old;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void increment(counter& c) BOOST_NOEXCEPT_OR_NOTHROW { ++c; }
+#endif
+
+// Call site counts (window packs interval index in high bits and count of
+// failures in that interval in low bits, so both updated by a single CAS).
+
+boost::uint64_t const count_bits = 24;
+boost::uint64_t const max_count = (boost::uint64_t(1) << count_bits) - 1;
+std::size_t const max_sites = 512;
+
+struct site {
+    counter key; // Hash of call site (0 if slot not claimed yet).
+    counter window;
+    counter suppressed; // Since previous report.
+};
+
+// All zero-initialized (as static, and atomic has trivial default ctor).
+struct state {
+    counter max_reports;
+    counter interval_ms;
+    site sites[max_sites];
+};
+
+struct state_tag;
+typedef boost::contract::detail::static_local_var<state_tag, state> all_state;
+
+struct mutex_tag;
+typedef boost::contract::detail::static_local_var<mutex_tag, boost::mutex>
+        mutex;
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+boost::uint64_t hash(boost::uint64_t h, char const* s)
+        BOOST_NOEXCEPT_OR_NOTHROW { // FNV-1a.
+    if(s) for(; *s != '\0'; ++s) h = (h ^ static_cast<unsigned char>(*s)) *
+            UINT64_C(0x100000001b3);
+    return h;
+}
+
+// Identify call site of active exception (0 if none).
+BOOST_CONTRACT_DETAIL_DECLINLINE
+boost::uint64_t call_site() BOOST_NOEXCEPT_OR_NOTHROW {
+    #ifndef BOOST_NO_CXX11_HDR_EXCEPTION
+        if(!std::current_exception()) return 0; // Not called from handler.
+    #endif
+    boost::uint64_t const h = UINT64_C(0xcbf29ce484222325);
+    try { throw; }
+    catch(boost::contract::assertion_failure const& error) {
+        return hash(h, error.file()) ^ error.line();
+    } catch(std::exception const& error) {
+        return hash(h, typeid(error).name());
+    } catch(...) {}
+    return h;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+boost::uint64_t now_ms() BOOST_NOEXCEPT_OR_NOTHROW {
+    #ifndef BOOST_NO_CXX11_HDR_CHRONO
+        return static_cast<boost::uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        );
+    #else
+        return static_cast<boost::uint64_t>(std::time(0)) * 1000u;
+    #endif
+}
+
+// Find slot of call site (claiming one if needed, 0 if table full).
+BOOST_CONTRACT_DETAIL_DECLINLINE
+site* find(state& s, boost::uint64_t key) BOOST_NOEXCEPT_OR_NOTHROW {
+    if(key == 0) key = 1; // As 0 marks free slots.
+    for(std::size_t i = 0; i < max_sites; ++i) {
+        site& t = s.sites[(key + i) % max_sites];
+        boost::uint64_t k = load(t.key);
+        if(k == 0) {
+            if(compare_exchange(t.key, k, key)) return &t;
+            // Else, k set to key of thread that claimed this slot first.
+        }
+        if(k == key) return &t;
+    }
+    return 0;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+failure_report report(state& s) BOOST_NOEXCEPT_OR_NOTHROW {
+    failure_report r;
+    r.report = true;
+    r.suppressed = 0;
+    boost::uint64_t const max_reports = load(s.max_reports);
+    if(max_reports == 0) return r; // No limit.
+
+    site* t = find(s, call_site());
+    if(!t) return r; // Too many call sites to track them all.
+
+    boost::uint64_t const interval_ms = load(s.interval_ms);
+    boost::uint64_t const index = (interval_ms == 0 ? 0 :
+            now_ms() / interval_ms) & (~boost::uint64_t(0) >> count_bits);
+    boost::uint64_t w = load(t->window), next;
+    do {
+        if((w >> count_bits) != index) next = (index << count_bits) | 1;
+        else next = w + ((w & max_count) < max_count ? 1 : 0);
+    } while(!compare_exchange(t->window, w, next));
+
+    if((next & max_count) <= max_reports) {
+        r.suppressed = take(t->suppressed);
+    } else {
+        r.report = false;
+        increment(t->suppressed);
+    }
+    return r;
+}
+
+} // namespace
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void set_failure_report_limit(boost::uint64_t max_reports,
+        boost::uint64_t interval_ms) BOOST_NOEXCEPT_OR_NOTHROW {
+    failure_report_::state& s = failure_report_::all_state::ref();
+    #ifdef BOOST_NO_CXX11_HDR_ATOMIC
+        boost::lock_guard<boost::mutex> lock(failure_report_::mutex::ref());
+    #endif
+    failure_report_::store(s.interval_ms, interval_ms);
+    failure_report_::store(s.max_reports, max_reports);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+failure_report report_failure() BOOST_NOEXCEPT_OR_NOTHROW {
+    failure_report_::state& s = failure_report_::all_state::ref();
+    #ifdef BOOST_NO_CXX11_HDR_ATOMIC
+        boost::lock_guard<boost::mutex> lock(failure_report_::mutex::ref());
+    #endif
+    return failure_report_::report(s);
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,172 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_CORE_MEMORY_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_CORE_MEMORY_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/core/memory.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    #include <atomic>
+#endif
+#include <cstddef>
+
+namespace boost { namespace contract { namespace memory_ {
+
+struct counters { // POD so zero-initialized.
+    std::ptrdiff_t bytes[kinds];
+    std::ptrdiff_t total;
+    std::ptrdiff_t peak;
+};
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void add(counters& c, kind k, std::ptrdiff_t bytes) BOOST_NOEXCEPT_OR_NOTHROW {
+    c.bytes[k] += bytes;
+    c.total += bytes;
+    if(c.total > c.peak) c.peak = c.total;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+memory_usage usage(counters const& c) BOOST_NOEXCEPT_OR_NOTHROW {
+    memory_usage u;
+    for(int k = 0; k < kinds; ++k) u.bytes_[k] = c.bytes[k];
+    u.peak_ = c.peak;
+    return u;
+}
+
+struct unlocked_thread_tag;
+typedef boost::contract::detail::static_local_var<unlocked_thread_tag,
+        counters> unlocked_thread_counters;
+
+struct unlocked_process_tag;
+typedef boost::contract::detail::static_local_var<unlocked_process_tag,
+        counters> unlocked_process_counters;
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    counters& thread_counters() BOOST_NOEXCEPT_OR_NOTHROW {
+        static thread_local counters c; // Zero-initialized.
+        return c;
+    }
+#endif // Else, thread counters are process counters (see below).
+
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    struct atomic_counters { // Zero-initialized (as static local var).
+        std::atomic<std::ptrdiff_t> bytes[kinds];
+        std::atomic<std::ptrdiff_t> total;
+        std::atomic<std::ptrdiff_t> peak;
+    };
+
+    struct process_tag;
+    typedef boost::contract::detail::static_local_var<process_tag,
+            atomic_counters> process_counters;
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void add_process(kind k, std::ptrdiff_t bytes) BOOST_NOEXCEPT_OR_NOTHROW {
+        atomic_counters& c = process_counters::ref();
+        c.bytes[k].fetch_add(bytes, std::memory_order_relaxed);
+        std::ptrdiff_t const total = c.total.fetch_add(bytes,
+                std::memory_order_relaxed) + bytes;
+        std::ptrdiff_t peak = c.peak.load(std::memory_order_relaxed);
+        while(total > peak && !c.peak.compare_exchange_weak(peak, total,
+                std::memory_order_relaxed)) {}
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    memory_usage process_usage() BOOST_NOEXCEPT_OR_NOTHROW {
+        atomic_counters& c = process_counters::ref();
+        memory_usage u;
+        for(int k = 0; k < kinds; ++k) {
+            u.bytes_[k] = c.bytes[k].load(std::memory_order_relaxed);
+        }
+        u.peak_ = c.peak.load(std::memory_order_relaxed);
+        return u;
+    }
+#else
+    struct process_tag;
+    typedef boost::contract::detail::static_local_var<process_tag, counters>
+            process_counters;
+
+    struct mutex_tag;
+    typedef boost::contract::detail::static_local_var<mutex_tag, boost::mutex>
+            mutex;
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void add_process(kind k, std::ptrdiff_t bytes) BOOST_NOEXCEPT_OR_NOTHROW {
+        boost::lock_guard<boost::mutex> lock(mutex::ref());
+        add(process_counters::ref(), k, bytes);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    memory_usage process_usage() BOOST_NOEXCEPT_OR_NOTHROW {
+        boost::lock_guard<boost::mutex> lock(mutex::ref());
+        return usage(process_counters::ref());
+    }
+#endif
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void add_unlocked(kind k, std::ptrdiff_t bytes) BOOST_NOEXCEPT_OR_NOTHROW {
+    add(unlocked_thread_counters::ref(), k, bytes);
+    add(unlocked_process_counters::ref(), k, bytes);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void add_locked(kind k, std::ptrdiff_t bytes) BOOST_NOEXCEPT_OR_NOTHROW {
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        add(thread_counters(), k, bytes);
+    #endif
+    add_process(k, bytes);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+memory_usage thread_usage_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
+    return usage(unlocked_thread_counters::ref());
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+memory_usage thread_usage_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        return usage(thread_counters());
+    #else
+        return process_usage();
+    #endif
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void reset_thread_peak_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
+    counters& c = unlocked_thread_counters::ref();
+    c.peak = c.total;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void reset_thread_peak_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        counters& c = thread_counters();
+        c.peak = c.total;
+    #endif // Else, process peak is never reset.
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+memory_usage process_usage_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
+    return usage(unlocked_process_counters::ref());
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+memory_usage process_usage_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+    return process_usage();
+}
+
+} } } // namespace
+
+#endif // #include guard
+
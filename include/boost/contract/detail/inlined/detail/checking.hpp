@@ -13,11 +13,55 @@
 #include <boost/contract/detail/checking.hpp>
 #include <boost/contract/detail/declspec.hpp>
 #include <boost/thread/lock_guard.hpp>
+#include <boost/config.hpp>
 
 namespace boost { namespace contract { namespace detail {
 
 BOOST_CONTRACT_DETAIL_DECLINLINE
-void checking::init_unlocked() { flag::ref() = true; }
+checking::stack& checking::shared_stack() {
+    static stack s = {0, 0};
+    return s;
+}
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    checking::stack& checking::thread_stack() {
+        static thread_local stack s = {0, 0};
+        return s;
+    }
+#endif
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void checking::init(stack& s) {
+    next_ = s.top;
+    s.top = this;
+    ++s.depth;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void checking::done(stack& s) {
+    // Top, unless stack shared by threads and their guards interleaved.
+    for(checking** g = &s.top; *g; g = &(*g)->next_) {
+        if(*g == this) {
+            *g = next_;
+            break;
+        }
+    }
+    --s.depth;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool checking::object_in(stack const& s, void const volatile* obj,
+        class_id id) {
+    if(!obj) return false;
+    for(checking* g = s.top; g; g = g->next_) {
+        if(g->obj_ == obj && g->id_ == id) return true;
+    }
+    return false;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void checking::init_unlocked() { init(shared_stack()); }
 
 BOOST_CONTRACT_DETAIL_DECLINLINE
 void checking::init_locked() {
@@ -26,7 +70,7 @@ void checking::init_locked() {
 }
 
 BOOST_CONTRACT_DETAIL_DECLINLINE
-void checking::done_unlocked() { flag::ref() = false; }
+void checking::done_unlocked() { done(shared_stack()); }
 
 BOOST_CONTRACT_DETAIL_DECLINLINE
 void checking::done_locked() {
@@ -35,14 +79,41 @@ void checking::done_locked() {
 }
 
 BOOST_CONTRACT_DETAIL_DECLINLINE
-bool checking::already_unlocked() { return flag::ref(); }
+unsigned checking::depth_unlocked() { return shared_stack().depth; }
     
 BOOST_CONTRACT_DETAIL_DECLINLINE
-bool checking::already_locked() {
+unsigned checking::depth_locked() {
     boost::lock_guard<boost::mutex> lock(mutex::ref());
-    return already_unlocked();
+    return depth_unlocked();
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool checking::object_unlocked(void const volatile* obj, class_id id) {
+    return object_in(shared_stack(), obj, id);
 }
 
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool checking::object_locked(void const volatile* obj, class_id id) {
+    boost::lock_guard<boost::mutex> lock(mutex::ref());
+    return object_unlocked(obj, id);
+}
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void checking::init_thread() { init(thread_stack()); }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void checking::done_thread() { done(thread_stack()); }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    unsigned checking::depth_thread() { return thread_stack().depth; }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    bool checking::object_thread(void const volatile* obj, class_id id) {
+        return object_in(thread_stack(), obj, id);
+    }
+#endif
+
 } } } // namespace
 
 #endif
@@ -0,0 +1,139 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_DETAIL_OLD_POOL_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_DETAIL_OLD_POOL_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/detail/old_pool.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/config.hpp>
+#include <new>
+#include <cstddef>
+
+namespace boost { namespace contract { namespace detail {
+
+namespace old_pool_ {
+    // Blocks up to classes * alignment bytes are pooled (larger use new).
+    std::size_t const classes = 16;
+    // Max blocks cached per size class (excess blocks returned to delete).
+    std::size_t const max_cached = 64;
+
+    struct block { block* next; };
+
+    struct free_lists { // POD so zero-initialized and never destructed.
+        block* heads[classes];
+        std::size_t counts[classes];
+        bool released; // Thread exited (so stop caching).
+    };
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    std::size_t size_class(std::size_t size) {
+        return (size + old_pool::alignment - 1) / old_pool::alignment - 1;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void* allocate(free_lists& lists, std::size_t size) {
+        std::size_t const c = size_class(size);
+        if(c >= classes) return ::operator new(size);
+        if(!lists.released && lists.heads[c]) {
+            block* b = lists.heads[c];
+            lists.heads[c] = b->next;
+            --lists.counts[c];
+            return b;
+        }
+        // Always full class size so any thread can later cache this block.
+        return ::operator new((c + 1) * old_pool::alignment);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void deallocate(free_lists& lists, void* p, std::size_t size) {
+        std::size_t const c = size_class(size);
+        if(c < classes && !lists.released && lists.counts[c] < max_cached) {
+            block* b = static_cast<block*>(p);
+            b->next = lists.heads[c];
+            lists.heads[c] = b;
+            ++lists.counts[c];
+        } else ::operator delete(p);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void release(free_lists& lists) {
+        for(std::size_t c = 0; c < classes; ++c) {
+            while(block* b = lists.heads[c]) {
+                lists.heads[c] = b->next;
+                ::operator delete(b);
+            }
+            lists.counts[c] = 0;
+        }
+        lists.released = true;
+    }
+
+    struct unlocked_tag;
+    typedef static_local_var<unlocked_tag, free_lists> unlocked_lists;
+
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        struct releaser {
+            explicit releaser(free_lists& lists) : lists_(lists) {}
+            ~releaser() { release(lists_); } // At thread exit.
+        private:
+            free_lists& lists_;
+        };
+
+        BOOST_CONTRACT_DETAIL_DECLINLINE
+        free_lists& thread_lists() {
+            static thread_local free_lists lists; // Zero-initialized.
+            static thread_local releaser r(lists);
+            return lists;
+        }
+    #else
+        struct locked_tag;
+        typedef static_local_var<locked_tag, free_lists> locked_lists;
+
+        struct mutex_tag;
+        typedef static_local_var<mutex_tag, boost::mutex> mutex;
+    #endif
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void* old_pool::allocate_unlocked(std::size_t size) {
+    return old_pool_::allocate(old_pool_::unlocked_lists::ref(), size);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void* old_pool::allocate_locked(std::size_t size) {
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        return old_pool_::allocate(old_pool_::thread_lists(), size);
+    #else
+        boost::lock_guard<boost::mutex> lock(old_pool_::mutex::ref());
+        return old_pool_::allocate(old_pool_::locked_lists::ref(), size);
+    #endif
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void old_pool::deallocate_unlocked(void* p, std::size_t size) {
+    old_pool_::deallocate(old_pool_::unlocked_lists::ref(), p, size);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void old_pool::deallocate_locked(void* p, std::size_t size) {
+    #ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        old_pool_::deallocate(old_pool_::thread_lists(), p, size);
+    #else
+        boost::lock_guard<boost::mutex> lock(old_pool_::mutex::ref());
+        old_pool_::deallocate(old_pool_::locked_lists::ref(), p, size);
+    #endif
+}
+
+} } } // namespace
+
+#endif // #include guard
+
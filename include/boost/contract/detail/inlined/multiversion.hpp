@@ -0,0 +1,79 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_MULTIVERSION_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_MULTIVERSION_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/multiversion.hpp>
+#include <boost/contract/detail/registry.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/config.hpp>
+#include <string>
+#include <cstddef>
+
+namespace boost { namespace contract { namespace multiversion_ {
+
+typedef boost::contract::detail::multiversion_base base;
+
+struct registry_traits { // Friend of multiversion_base.
+    typedef base object_type;
+    typedef bool value_type; // Versions selected by name.
+
+    static base*& next(base& m) { return m.next_; }
+
+    static bool matches(base const& m, std::string const& name) {
+        return m.name_ && name == m.name_;
+    }
+
+    static void apply(base& m, bool checked) {
+        base::version_type const v = checked ? m.checked_ : m.unchecked_;
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            m.current_.store(v, std::memory_order_relaxed);
+        #else
+            m.current_ = v;
+        #endif
+    }
+
+    static bool replaces(bool, bool) { return true; }
+};
+
+typedef boost::contract::detail::registry<registry_traits> registry;
+
+} // namespace
+
+namespace detail {
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+multiversion_base::multiversion_base(char const* name, version_type checked,
+        version_type unchecked) : name_(name), checked_(checked),
+        unchecked_(unchecked), current_(checked), next_(0) {
+    boost::lock_guard<boost::mutex> lock(multiversion_::registry::mutex());
+    multiversion_::registry::ref().add(*this);
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+multiversion_base::~multiversion_base() {
+    boost::lock_guard<boost::mutex> lock(multiversion_::registry::mutex());
+    multiversion_::registry::ref().remove(*this);
+}
+
+} // namespace
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+std::size_t set_multiversion_checked(std::string const& name, bool checked) {
+    boost::lock_guard<boost::mutex> lock(multiversion_::registry::mutex());
+    return multiversion_::registry::ref().set(name, checked);
+}
+
+} } // namespace
+
+#endif // #include guard
+
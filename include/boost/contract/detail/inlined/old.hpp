@@ -11,10 +11,171 @@
 // .cpp does not need recompiling if config changes (recompile only user code).
 
 #include <boost/contract/old.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
 #include <boost/contract/detail/declspec.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    #include <atomic>
+#endif
+#include <vector>
+#include <cstddef>
 
 namespace boost { namespace contract {
 
+namespace old_ {
+    struct reclaimer_mutex_tag;
+    typedef boost::contract::detail::static_local_var<reclaimer_mutex_tag,
+            boost::mutex> reclaimer_mutex;
+
+    // Reclaimers replaced by later ones, but still kept as releases (on any
+    // thread) might be calling them via pointer (without locking nor copying
+    // them). Freed once no release is calling any reclaimer.
+    struct reclaimers {
+        ~reclaimers();
+        std::vector<old_value_reclaimer const*> replaced;
+    };
+
+    struct reclaimers_tag;
+    typedef boost::contract::detail::static_local_var<reclaimers_tag,
+            reclaimers> all_reclaimers;
+
+    struct reclaimer_tag;
+    struct pins_tag;
+    #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+        typedef boost::contract::detail::static_local_var<reclaimer_tag,
+                std::atomic<old_value_reclaimer const*> > reclaimer;
+        // Number of releases calling a reclaimer (zero-init, as static).
+        typedef boost::contract::detail::static_local_var<pins_tag,
+                std::atomic<std::size_t> > pins;
+    #else // Read under mutex when threads (see pin_reclaimer_locked).
+        typedef boost::contract::detail::static_local_var<reclaimer_tag,
+                old_value_reclaimer const*> reclaimer;
+        typedef boost::contract::detail::static_local_var<pins_tag,
+                std::size_t> pins;
+    #endif
+
+    // Sequentially consistent, so either a release pins before reclaimer is
+    // replaced (then replaced one not freed), or it loads the new reclaimer.
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void store_reclaimer(old_value_reclaimer const* r)
+            BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            reclaimer::ref().store(r, std::memory_order_seq_cst);
+        #else
+            reclaimer::ref() = r;
+        #endif
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    old_value_reclaimer const* load_reclaimer() BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            return reclaimer::ref().load(std::memory_order_seq_cst);
+        #else
+            return reclaimer::ref();
+        #endif
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    reclaimers::~reclaimers() {
+        old_value_reclaimer const* const r = load_reclaimer();
+        store_reclaimer(0); // Copies released after exit destroyed in place.
+        delete r;
+        for(std::vector<old_value_reclaimer const*>::const_iterator i =
+                replaced.begin(); i != replaced.end(); ++i) delete *i;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    old_value_reclaimer const& set_reclaimer_unlocked(
+            old_value_reclaimer const& f) {
+        std::vector<old_value_reclaimer const*>& replaced =
+                all_reclaimers::ref().replaced;
+        // If these throw, nothing changed (previous reclaimer still set).
+        replaced.reserve(replaced.size() + 1); // So push_back does not throw.
+        old_value_reclaimer const* const r = f ? new old_value_reclaimer(f) : 0;
+
+        old_value_reclaimer const* const previous = load_reclaimer();
+        store_reclaimer(r);
+        if(previous) replaced.push_back(previous);
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            bool const pinned = pins::ref().load(std::memory_order_seq_cst) > 0;
+        #else
+            bool const pinned = pins::ref() > 0;
+        #endif
+        if(!pinned) { // Else, freed by a later set (or at exit).
+            for(std::vector<old_value_reclaimer const*>::const_iterator i =
+                    replaced.begin(); i != replaced.end(); ++i) delete *i;
+            replaced.clear();
+        }
+        return f;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    old_value_reclaimer const& set_reclaimer_locked(
+            old_value_reclaimer const& f) {
+        boost::lock_guard<boost::mutex> lock(reclaimer_mutex::ref());
+        return set_reclaimer_unlocked(f);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    old_value_reclaimer const* reclaimer_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
+        return load_reclaimer();
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    old_value_reclaimer const* reclaimer_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            return load_reclaimer(); // Atomic, no lock needed.
+        #else
+            boost::lock_guard<boost::mutex> lock(reclaimer_mutex::ref());
+            return load_reclaimer();
+        #endif
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    old_value_reclaimer const* pin_reclaimer_unlocked()
+            BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            pins::ref().fetch_add(1, std::memory_order_seq_cst);
+        #else
+            ++pins::ref();
+        #endif
+        return load_reclaimer();
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void unpin_reclaimer_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            pins::ref().fetch_sub(1, std::memory_order_release);
+        #else
+            --pins::ref();
+        #endif
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    old_value_reclaimer const* pin_reclaimer_locked()
+            BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            return pin_reclaimer_unlocked(); // Atomic, no lock needed.
+        #else
+            boost::lock_guard<boost::mutex> lock(reclaimer_mutex::ref());
+            return pin_reclaimer_unlocked();
+        #endif
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void unpin_reclaimer_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+            unpin_reclaimer_unlocked();
+        #else
+            boost::lock_guard<boost::mutex> lock(reclaimer_mutex::ref());
+            unpin_reclaimer_unlocked();
+        #endif
+    }
+}
+
 BOOST_CONTRACT_DETAIL_DECLINLINE
 old_value null_old() { return old_value(); }
 
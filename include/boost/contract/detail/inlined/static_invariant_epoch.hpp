@@ -0,0 +1,91 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_STATIC_INVARIANT_EPOCH_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_STATIC_INVARIANT_EPOCH_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/static_invariant_epoch.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/config.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    #include <atomic>
+#endif
+
+namespace boost { namespace contract { namespace static_invariant_epoch_ {
+
+struct unlocked_tag;
+typedef boost::contract::detail::static_local_var<unlocked_tag, unsigned long>
+        unlocked_epoch;
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+unsigned long current_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
+    return unlocked_epoch::ref();
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void advance_unlocked() BOOST_NOEXCEPT_OR_NOTHROW { ++unlocked_epoch::ref(); }
+
+struct mutex_tag;
+typedef boost::contract::detail::static_local_var<mutex_tag, boost::mutex>
+        mutex;
+
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    struct tag;
+    typedef boost::contract::detail::static_local_var<tag,
+            std::atomic<unsigned long> > epoch; // Zero-initialized (as static).
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    unsigned long current_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+        return epoch::ref().load(std::memory_order_acquire);
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void advance_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+        epoch::ref().fetch_add(1, std::memory_order_acq_rel);
+    }
+#else
+    struct tag;
+    typedef boost::contract::detail::static_local_var<tag, unsigned long>
+            epoch;
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    unsigned long current_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+        boost::lock_guard<boost::mutex> lock(mutex::ref());
+        return epoch::ref();
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void advance_locked() BOOST_NOEXCEPT_OR_NOTHROW {
+        boost::lock_guard<boost::mutex> lock(mutex::ref());
+        ++epoch::ref();
+    }
+#endif
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+bool checked_locked(unsigned long const& last, unsigned long& epoch)
+        BOOST_NOEXCEPT_OR_NOTHROW {
+    epoch = current_locked() + 1;
+    boost::lock_guard<boost::mutex> lock(mutex::ref());
+    return last == epoch;
+}
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+void check_locked(unsigned long& last, unsigned long epoch)
+        BOOST_NOEXCEPT_OR_NOTHROW {
+    boost::lock_guard<boost::mutex> lock(mutex::ref());
+    last = epoch;
+}
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,151 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_OLD_POOL_HPP_
+#define BOOST_CONTRACT_DETAIL_OLD_POOL_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/memory.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/config.hpp>
+#include <memory>
+#include <new>
+#include <cstddef>
+
+namespace boost { namespace contract { namespace detail {
+
+#ifdef BOOST_MSVC
+    #pragma warning(push)
+    #pragma warning(disable: 4275) // Base w/o DLL spec (noncopyable).
+#endif
+
+// Memory for old value copies (each copy together with its shared_ptr control
+// block, see old_allocator below). Old values are copied and released on every
+// contract check so freed blocks are cached on per-thread (when supported by
+// the compiler, otherwise on mutex-protected global) free lists and recycled by
+// later copies of the same size class. Blocks are individually obtained from
+// and returned to the global operator new/delete so they can be released by a
+// thread other than the one that allocated them (old_ptr is copyable).
+class BOOST_CONTRACT_DETAIL_DECLSPEC old_pool :
+    private boost::noncopyable // Only static members.
+{
+public:
+    // Same alignment as operator new guarantees (larger alignments not pooled).
+    union max_align { long double d; long long l; void* p; void (*f)(); };
+    static std::size_t const alignment =
+            boost::alignment_of<max_align>::value;
+
+    static void* allocate(std::size_t size) {
+        #ifndef BOOST_CONTRACT_DISABLE_THREADS
+            return allocate_locked(size);
+        #else
+            return allocate_unlocked(size);
+        #endif
+    }
+
+    static void deallocate(void* p, std::size_t size) {
+        #ifndef BOOST_CONTRACT_DISABLE_THREADS
+            deallocate_locked(p, size);
+        #else
+            deallocate_unlocked(p, size);
+        #endif
+    }
+
+    // Not cached (e.g., for blocks released by threads that do not copy).
+    static void release(void* p) { ::operator delete(p); }
+
+private:
+    static void* allocate_unlocked(std::size_t size);
+    static void* allocate_locked(std::size_t size);
+
+    static void deallocate_unlocked(void* p, std::size_t size);
+    static void deallocate_locked(void* p, std::size_t size);
+};
+
+#ifdef BOOST_MSVC
+    #pragma warning(pop)
+#endif
+
+// Allocator for boost::allocate_shared that draws from old_pool (so old value
+// copy and shared_ptr control block take one single recycled allocation).
+template<typename T>
+class old_allocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T const* const_pointer;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template<typename U>
+    struct rebind { typedef old_allocator<U> other; };
+
+    old_allocator() BOOST_NOEXCEPT_OR_NOTHROW {}
+
+    template<typename U>
+    old_allocator(old_allocator<U> const&) BOOST_NOEXCEPT_OR_NOTHROW {}
+
+    T* allocate(std::size_t n, void const* = 0) {
+        account_memory(boost::contract::memory_::old_values_kind,
+                std::ptrdiff_t(n * sizeof(T)));
+        if(!pooled::value) return std::allocator<T>().allocate(n);
+        return static_cast<T*>(old_pool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        account_memory(boost::contract::memory_::old_values_kind,
+                -std::ptrdiff_t(n * sizeof(T)));
+        if(!pooled::value) std::allocator<T>().deallocate(p, n);
+        else old_pool::deallocate(p, n * sizeof(T));
+    }
+
+    // Deallocate without caching block in free lists of calling thread.
+    void release(T* p, std::size_t n) {
+        account_memory(boost::contract::memory_::old_values_kind,
+                -std::ptrdiff_t(n * sizeof(T)));
+        if(!pooled::value) std::allocator<T>().deallocate(p, n);
+        else old_pool::release(p);
+    }
+
+    std::size_t max_size() const BOOST_NOEXCEPT_OR_NOTHROW {
+        return std::size_t(-1) / sizeof(T);
+    }
+
+    T* address(T& x) const { return &x; }
+    T const* address(T const& x) const { return &x; }
+
+    void construct(T* p, T const& x) { ::new(static_cast<void*>(p)) T(x); }
+    void destroy(T* p) { p->~T(); }
+
+private:
+    struct pooled { // Over-aligned types use std::allocator instead.
+        static bool const value =
+                boost::alignment_of<T>::value <= old_pool::alignment;
+    };
+};
+
+template<typename T, typename U>
+inline bool operator==(old_allocator<T> const&, old_allocator<U> const&) {
+    return true;
+}
+
+template<typename T, typename U>
+inline bool operator!=(old_allocator<T> const&, old_allocator<U> const&) {
+    return false;
+}
+
+} } } // namespace
+
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/detail/old_pool.hpp>
+#endif
+
+#endif // #include guard
+
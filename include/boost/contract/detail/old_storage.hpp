@@ -0,0 +1,136 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_OLD_STORAGE_HPP_
+#define BOOST_CONTRACT_DETAIL_OLD_STORAGE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/old_pool.hpp>
+#include <boost/contract/detail/debug.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/config.hpp>
+#include <cstring>
+
+// Non-atomic ref count when threads disabled (local_shared_ptr needs C++11).
+#if defined(BOOST_CONTRACT_DISABLE_THREADS) && \
+        !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && \
+        !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    #define BOOST_CONTRACT_DETAIL_OLD_LOCAL_SHARED_PTR
+    #include <boost/smart_ptr/local_shared_ptr.hpp>
+    #include <boost/smart_ptr/make_local_shared.hpp>
+#else
+    #include <boost/make_shared.hpp>
+    #include <boost/shared_ptr.hpp>
+#endif
+
+namespace boost { namespace contract { namespace detail {
+
+template<typename T>
+struct old_shared_ptr {
+    #ifdef BOOST_CONTRACT_DETAIL_OLD_LOCAL_SHARED_PTR
+        typedef boost::local_shared_ptr<T> type;
+    #else
+        typedef boost::shared_ptr<T> type;
+    #endif
+};
+
+// Copy old value (together with its ref count) into one old_pool block.
+template<class C, typename T>
+typename old_shared_ptr<C>::type allocate_old(T const& old) {
+    #ifdef BOOST_CONTRACT_DETAIL_OLD_LOCAL_SHARED_PTR
+        return boost::allocate_local_shared<C>(old_allocator<C>(), old);
+    #else
+        return boost::allocate_shared<C>(old_allocator<C>(), old);
+    #endif
+}
+
+// In-place storage for small trivially copyable old value copies (e.g., sizes,
+// counters, iterators, small PODs) so these need no heap and no ref count.
+union old_inline_buffer {
+    old_pool::max_align align_;
+    char bytes_[16];
+};
+
+template<class C> // C is old_value_copy<T> (so user specializations honored).
+struct old_inline : boost::mpl::bool_<
+    sizeof(C) <= sizeof(old_inline_buffer) &&
+    boost::alignment_of<C>::value <=
+            boost::alignment_of<old_inline_buffer>::value &&
+    boost::has_trivial_copy<C>::value &&
+    boost::has_trivial_destructor<C>::value
+> {};
+
+// Typed storage of old value copy held by old_ptr, old_ptr_if_copyable.
+template<class C, bool Inline>
+class old_storage;
+
+template<class C>
+class old_storage<C, false> { // Shared (ref counted) copy.
+public:
+    old_storage() {}
+
+    explicit old_storage(typename old_shared_ptr<void>::type const& untyped,
+            old_inline_buffer const& /* buffer */, bool inlined) :
+        copy_(boost::static_pointer_cast<C>(untyped)) // Un-erase type.
+    { BOOST_CONTRACT_DETAIL_DEBUG(!inlined); }
+
+    C const* get() const { return copy_.get(); }
+
+    // Type-erased shared copy (e.g., to queue copies for subcontracting).
+    static typename old_shared_ptr<void>::type share(
+        typename old_shared_ptr<void>::type const& untyped,
+        old_inline_buffer const& /* buffer */,
+        bool inlined
+    ) {
+        BOOST_CONTRACT_DETAIL_DEBUG(!inlined);
+        return untyped;
+    }
+
+private:
+    typename old_shared_ptr<C>::type copy_;
+};
+
+template<class C>
+class old_storage<C, true> { // In-place copy (trivially copyable).
+public:
+    old_storage() : copied_(false) {}
+
+    explicit old_storage(typename old_shared_ptr<void>::type const& untyped,
+            old_inline_buffer const& buffer, bool inlined) : copied_(true) {
+        if(inlined) buffer_ = buffer;
+        else { // Shared copy popped from subcontracting queue.
+            BOOST_CONTRACT_DETAIL_DEBUG(untyped);
+            std::memcpy(&buffer_, untyped.get(), sizeof(C));
+        }
+    }
+
+    C const* get() const {
+        if(!copied_) return 0;
+        return static_cast<C const*>(static_cast<void const*>(&buffer_));
+    }
+
+    static typename old_shared_ptr<void>::type share(
+        typename old_shared_ptr<void>::type const& untyped,
+        old_inline_buffer const& buffer,
+        bool inlined
+    ) {
+        if(!inlined) return untyped;
+        return allocate_old<C>(*static_cast<C const*>(
+                static_cast<void const*>(&buffer)));
+    }
+
+private:
+    old_inline_buffer buffer_;
+    bool copied_;
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,72 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_BULK_CONSTRUCTOR_HPP_
+#define BOOST_CONTRACT_DETAIL_BULK_CONSTRUCTOR_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/condition/cond_inv.hpp>
+#include <boost/contract/detail/bulk.hpp>
+#include <boost/contract/detail/none.hpp>
+#if     !defined(BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION) && \
+        !defined(BOOST_CONTRACT_NO_INVARIANTS)
+    #include <boost/contract/detail/checking.hpp>
+#endif
+#include <boost/config.hpp>
+
+namespace boost { namespace contract { namespace detail {
+
+// Ctor contracts of many objs, checked once for the entire batch.
+template<class C> // Non-copyable base.
+class bulk_constructor : public cond_inv</* VR = */ none, C> {
+public:
+    explicit bulk_constructor() : cond_inv</* VR = */ none, C>(
+            boost::contract::from_constructor, /* obj = */ 0) {}
+
+    // No obj before ctor bodies so only static inv at entry (see init), then
+    // static and non-static inv of all objs after their ctors.
+    template<typename Iter>
+    void check(Iter
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            first
+        #endif
+        , Iter
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            last
+        #endif
+    ) {
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+                if(checking::already()) return;
+                checking k;
+            #endif
+            this->check_exit_all_inv_range(first, last);
+        #endif
+    }
+
+    ~bulk_constructor() BOOST_NOEXCEPT_IF(false) {
+        this->assert_initialized();
+        bulk<C>::resume();
+    }
+
+private:
+    void init() /* override */ {
+        bulk<C>::defer(); // Skip contracts of each ctor in batch.
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+                if(checking::already()) return;
+                checking k;
+            #endif
+            this->check_entry_static_inv();
+        #endif
+    }
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,74 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_BULK_DESTRUCTOR_HPP_
+#define BOOST_CONTRACT_DETAIL_BULK_DESTRUCTOR_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/condition/cond_inv.hpp>
+#include <boost/contract/detail/bulk.hpp>
+#include <boost/contract/detail/none.hpp>
+#if     !defined(BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION) && \
+        !defined(BOOST_CONTRACT_NO_INVARIANTS)
+    #include <boost/contract/detail/checking.hpp>
+#endif
+#include <boost/config.hpp>
+
+namespace boost { namespace contract { namespace detail {
+
+// Dtor contracts of many objs, checked once for the entire batch.
+template<class C> // Non-copyable base.
+class bulk_destructor : public cond_inv</* VR = */ none, C> {
+public:
+    explicit bulk_destructor() : cond_inv</* VR = */ none, C>(
+            boost::contract::from_destructor, /* obj = */ 0) {}
+
+    // Objs exist before dtor bodies so static and non-static inv of all objs
+    // (called after initialize defers dtor contracts so, even if this throws,
+    // dtor below still resumes them).
+    template<typename Iter>
+    void check(Iter
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            first
+        #endif
+        , Iter
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            last
+        #endif
+    ) {
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+                if(checking::already()) return;
+                checking k;
+            #endif
+            this->check_entry_all_inv_range(first, last);
+        #endif
+    }
+
+    // No obj after dtor bodies so only static inv at exit.
+    ~bulk_destructor() BOOST_NOEXCEPT_IF(false) {
+        this->assert_initialized();
+        bulk<C>::resume();
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+                if(checking::already()) return;
+                checking k;
+            #endif
+            this->check_exit_static_inv();
+        #endif
+    }
+
+private:
+    void init() /* override */ {
+        bulk<C>::defer(); // Skip contracts of each dtor in batch.
+    }
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -10,6 +10,7 @@
 #include <boost/contract/core/exception.hpp>
 #include <boost/contract/core/config.hpp>
 #include <boost/contract/detail/condition/cond_inv.hpp>
+#include <boost/contract/detail/bulk.hpp>
 #include <boost/contract/detail/none.hpp>
 #include <boost/contract/detail/exception.hpp>
 #if     !defined(BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION) && ( \
@@ -38,6 +39,7 @@ private:
     #if     !defined(BOOST_CONTRACT_NO_ENTRY_INVARIANTS) || \
             !defined(BOOST_CONTRACT_NO_OLDS)
         void init() /* override */ {
+            if(bulk<C>::deferred()) return; // Checked for entire batch.
             #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
             #endif
@@ -45,7 +47,7 @@ private:
             #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
                 {
                     #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
-                        checking k;
+                        checking k(this->object());
                     #endif
                     // Obj exists (before dtor body), check static and non- inv.
                     this->check_entry_all_inv();
@@ -64,9 +66,10 @@ public:
             !defined(BOOST_CONTRACT_NO_EXCEPTS)
         ~destructor() BOOST_NOEXCEPT_IF(false) {
             this->assert_initialized();
+            if(bulk<C>::deferred()) return;
             #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
-                checking k;
+                checking k(this->object());
             #endif
 
             // If dtor body threw, obj still exists so check subcontracted
@@ -81,7 +81,7 @@ private:
                 #endif
                 { // Acquire checking guard.
                     #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
-                        checking k;
+                        checking k(this->object());
                     #endif
                     #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
                         this->check_subcontracted_entry_inv();
@@ -136,7 +136,7 @@ public:
             if(!this->base_call()) {
                 #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                     if(checking::already()) return;
-                    checking k;
+                    checking k(this->object());
                 #endif
 
                 #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
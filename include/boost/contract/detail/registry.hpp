@@ -0,0 +1,105 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_REGISTRY_HPP_
+#define BOOST_CONTRACT_DETAIL_REGISTRY_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/noncopyable.hpp>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+namespace boost { namespace contract { namespace detail {
+
+// Objects registered from their construction to their destruction (call sites,
+// domains, etc.) as intrusive list, with values set by key so far (applied in
+// order also to objects registered later). Traits (friend of objects) has:
+//   typedef ... object_type;
+//   typedef ... value_type;
+//   static object_type*& next(object_type& o);
+//   static bool matches(object_type const& o, std::string const& key);
+//   static void apply(object_type& o, value_type const& value);
+//   // True if value set for a key replaces old value set for same key.
+//   static bool replaces(value_type const& value, value_type const& old);
+// All members must be called with mutex() locked.
+template<class Traits>
+class registry : private boost::noncopyable {
+public:
+    typedef typename Traits::object_type object_type;
+    typedef typename Traits::value_type value_type;
+
+    registry() : head_(0) {}
+
+    // Local statics, so constructed by first object registered (and destructed
+    // after objects with static storage duration unregistered).
+    static registry& ref() {
+        return static_local_var<registry, registry>::ref();
+    }
+
+    static boost::mutex& mutex() {
+        return static_local_var<registry, boost::mutex>::ref();
+    }
+
+    object_type* head() const { return head_; }
+
+    void add(object_type& o) {
+        for(typename rules::const_iterator r = rules_.begin();
+                r != rules_.end(); ++r) {
+            if(Traits::matches(o, r->first)) Traits::apply(o, r->second);
+        }
+        Traits::next(o) = head_;
+        head_ = &o;
+    }
+
+    // So no dangling object after it is destructed (e.g., lib unloaded).
+    void remove(object_type& o) {
+        for(object_type** p = &head_; *p; p = &Traits::next(**p)) {
+            if(*p == &o) {
+                *p = Traits::next(o);
+                return;
+            }
+        }
+    }
+
+    // Return number of registered objects matching key.
+    std::size_t set(std::string const& key, value_type const& value) {
+        // Replaced (so rules do not grow when same key set again), and moved
+        // last (so still applied after other keys set before).
+        for(typename rules::iterator r = rules_.begin(); r != rules_.end();
+                ++r) {
+            if(r->first == key && Traits::replaces(value, r->second)) {
+                rules_.erase(r);
+                break;
+            }
+        }
+        rules_.push_back(std::make_pair(key, value));
+        std::size_t count = 0;
+        for(object_type* o = head_; o; o = Traits::next(*o)) {
+            if(Traits::matches(*o, key)) {
+                Traits::apply(*o, value);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+private:
+    typedef std::vector<std::pair<std::string, value_type> > rules;
+
+    object_type* head_;
+    rules rules_;
+};
+
+} } } // namespace
+
+#endif // #include guard
+
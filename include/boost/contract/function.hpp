@@ -13,6 +13,7 @@ Program contracts for (non-public) functions.
 
 #include <boost/contract/core/config.hpp>
 #include <boost/contract/core/specify.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 #if     !defined(BOOST_CONTRACT_NO_FUNCTIONS) || \
         !defined(BOOST_CONTRACT_NO_INVARIANTS) || \
          defined(BOOST_CONTRACT_STATIC_LINK)
@@ -83,6 +84,60 @@ inline specify_precondition_old_postcondition_except<> function() {
     #endif
 }
 
+/**
+Program contracts for non-member, private and protected functions that are
+checked.
+
+This is equivalent to @RefFunc{boost::contract::function}.
+It is used together with <c>boost::contract::function(boost::false_type)</c> to
+program a function body template with a @c bool parameter that selects
+at compile-time whether its contracts are checked (e.g., to call its checked and
+unchecked instantiations via @RefClass{boost::contract::multiversion}):
+
+@code
+template<bool Checked>
+void f_(...) {
+    boost::contract::check c = boost::contract::function(
+            boost::integral_constant<bool, Checked>())
+        .precondition(...)
+        ...
+    ;
+
+    ... // Function body.
+}
+@endcode
+
+@see @RefSect{extras.multiversioning, Multiversioning}
+
+@return The result of this function must be explicitly assigned to a variable of
+        type @RefClass{boost::contract::check} declared locally just before the
+        function body code (otherwise this library will generate a run-time
+        error, see @RefMacro{BOOST_CONTRACT_ON_MISSING_CHECK_DECL}).
+*/
+inline specify_precondition_old_postcondition_except<> function(
+        boost::true_type) {
+    return boost::contract::function();
+}
+
+/**
+Program contracts for non-member, private and protected functions that are never
+checked.
+
+The returned object ignores all specified functors and it does not allocate nor
+check any contract, so function body instantiations using this contain no
+contract code once optimized (see
+<c>boost::contract::function(boost::true_type)</c>).
+
+@see @RefSect{extras.multiversioning, Multiversioning}
+
+@return The result of this function must be explicitly assigned to a variable of
+        type @RefClass{boost::contract::check} declared locally just before the
+        function body code.
+*/
+inline specify_unchecked function(boost::false_type) {
+    return specify_unchecked();
+}
+
 } } // namespace
 
 #endif // #include guard
@@ -0,0 +1,58 @@
+
+#ifndef BOOST_CONTRACT_INVARIANT_POLICY_HPP_
+#define BOOST_CONTRACT_INVARIANT_POLICY_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Select which class invariants are checked.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+namespace boost { namespace contract {
+
+/**
+Trait to check (or not) exit invariants of @c const public functions.
+
+By default, this trait is @c true unless
+@RefMacro{BOOST_CONTRACT_NO_CONST_EXIT_INVARIANTS} is defined.
+When this trait is @c false, this library does not check non-static invariants
+at exit of @c const (but not @c volatile) public functions of the specified
+class.
+Programmers can specialize this trait to @c false for classes that do not
+change their state in @c const public functions (i.e., classes without
+@c mutable data members, or classes that do not use them in ways that can break
+their invariants), halving the cost of invariant checks for these functions.
+Static invariants, and invariants of @c volatile public functions, constructors,
+and destructors are always checked.
+
+@code
+namespace boost { namespace contract {
+    template<>
+    struct check_const_exit_invariants<my_read_mostly_class> : boost::false_type {};
+} }
+@endcode
+
+@see @RefSect{extras.invariant_policies, Invariant Policies}
+
+@tparam C   Class (without @c const and @c volatile qualifiers) of the
+            invariants.
+*/
+template<class C>
+struct check_const_exit_invariants :
+    #ifndef BOOST_CONTRACT_NO_CONST_EXIT_INVARIANTS
+        boost::true_type
+    #else
+        boost::false_type
+    #endif
+{};
+
+} } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,160 @@
+
+#ifndef BOOST_CONTRACT_INVARIANT_VERSION_HPP_
+#define BOOST_CONTRACT_INVARIANT_VERSION_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Skip entry invariants of objects not changed since their invariants were last
+checked.
+*/
+
+#include <cstddef>
+
+namespace boost { namespace contract {
+
+class access;
+
+/**
+Base class to skip entry invariants of objects that have not changed since their
+invariants were last checked.
+
+Classes with expensive invariants can inherit from this class (publicly, or
+privately if they also declare @RefClass{boost::contract::access} friend).
+Then this library records the version of the object every time its
+(non-volatile) invariants are checked successfully at exit of constructors and
+public functions, and it skips checking these invariants at entry of public
+functions if the object version has not changed since (static and volatile
+invariants are always checked).
+Versions are never recorded when exit invariants are not checked (e.g., when
+@RefMacro{BOOST_CONTRACT_NO_EXIT_INVARIANTS} is defined) or when they are
+checked for many objects at once (see
+@RefClass{boost::contract::bulk_constructor}), so entry invariants are then
+always checked.
+Invariants are still always checked at exit of public functions, so the object
+version needs to be changed only by code that changes the object without exit
+invariant checks, for example:
+
+@li Functions that are not contracted (or friends, etc.) that modify the object.
+@li Code modifying the object via references, pointers, iterators, etc. returned
+    by the object public functions (note that invariants are checked at the
+    exit of the function returning the reference, not after the reference is
+    used to modify the object).
+@li Other objects that share state with this object.
+
+@code
+class vector : private boost::contract::invariant_version {
+    friend class boost::contract::access;
+
+    void invariant() const { ... } // Expensive (e.g., linear complexity).
+
+public:
+    T& operator[](size_type i) {
+        invariant_changed(); // Reference might be used to change this object.
+        ...
+    }
+
+    ...
+};
+@endcode
+
+Object versions are not synchronized, so objects shared by multiple threads
+should not use this class unless all their accesses are externally synchronized
+(including calls to @c const public functions).
+
+@see @RefSect{extras.invariant_versions, Invariant Versions}
+*/
+class invariant_version { // Copyable (as *).
+public:
+    /** Construct this object (its invariants not checked yet). */
+    invariant_version() : version_(1), next_(0) { clear(); }
+
+    /**
+    Construct this object as a copy (its invariants not checked yet).
+
+    Copies are distinct objects so invariants checked for the copied object are
+    not considered checked for the new one.
+    */
+    invariant_version(invariant_version const&) : version_(1), next_(0) {
+        clear();
+    }
+
+    /** Assign this object (changing its version). */
+    invariant_version& operator=(invariant_version const&) {
+        invariant_changed();
+        return *this;
+    }
+
+protected:
+    /**
+    Change the version of this object.
+
+    This must be called when this object might be changed in ways that do not
+    check its exit invariants (so its invariants will be checked again at entry
+    of the next public function call).
+    This is a @c const member function so it can also be called when
+    @c mutable data members are changed.
+    */
+    void invariant_changed() const { ++version_; }
+
+    /** Destruct this object (only by derived classes, not polymorphic). */
+    ~invariant_version() {}
+
+/** @cond */
+private:
+    typedef char const* class_id; // Identify class that checked invariants.
+
+    static std::size_t const max_classes = 4; // Classes recorded per object.
+
+    struct record { // Versions at which invariants of classes were checked.
+        class_id id;
+        unsigned long version;
+    };
+
+    void clear() {
+        for(std::size_t i = 0; i < max_classes; ++i) {
+            records_[i].id = 0;
+            records_[i].version = 0;
+        }
+    }
+
+    bool checked(class_id id) const {
+        for(std::size_t i = 0; i < max_classes; ++i) {
+            if(records_[i].id == id) return records_[i].version == version_;
+        }
+        return false;
+    }
+
+    void check(class_id id) const {
+        record* r = 0;
+        for(std::size_t i = 0; i < max_classes; ++i) {
+            if(records_[i].id == id) { r = &records_[i]; break; }
+            // Else, replace first outdated record (if any).
+            if(!r && records_[i].version != version_) r = &records_[i];
+        }
+        if(!r) r = &records_[next_++ % max_classes]; // Else, round robin.
+        r->id = id;
+        r->version = version_;
+    }
+
+    void uncheck(class_id id) const { // Invariants failed (so check again).
+        for(std::size_t i = 0; i < max_classes; ++i) {
+            if(records_[i].id == id) records_[i].version = 0;
+        }
+    }
+
+    mutable unsigned long version_;
+    mutable std::size_t next_;
+    mutable record records_[max_classes];
+
+    friend class access;
+/** @endcond */
+};
+
+} } // namespace
+
+#endif // #include guard
+
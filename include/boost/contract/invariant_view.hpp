@@ -0,0 +1,109 @@
+
+#ifndef BOOST_CONTRACT_INVARIANT_VIEW_HPP_
+#define BOOST_CONTRACT_INVARIANT_VIEW_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Check class invariants on consistent read views of concurrently accessed
+objects.
+*/
+
+#include <boost/contract/core/config.hpp>
+
+namespace boost { namespace contract {
+
+/**
+Read view of an object used to check its non-static class invariants.
+
+This library constructs an object of this class before checking non-static
+class invariants of an object of the specified class, checks the invariants on
+the object returned by @RefMemberFunc{boost::contract::invariant_view, object},
+and then checks again (on a new view) if
+@RefMemberFunc{boost::contract::invariant_view, consistent} returns @c false
+(also when the invariants failed, because failures on inconsistent views are not
+reported).
+By default, this class checks invariants directly on the object, without any
+synchronization.
+Programmers can specialize this class for classes accessed concurrently by
+multiple threads, so invariants are checked on a consistent read view of the
+object without serializing its readers, for example:
+
+@li Holding a shared (reader) lock while the view is alive.
+@li Reading a sequence lock counter on construction, and then returning
+    @c false from @RefMemberFunc{boost::contract::invariant_view, consistent}
+    if that counter changed (so invariants are checked again).
+@li Copying a snapshot of the object on construction, and then returning the
+    snapshot from @RefMemberFunc{boost::contract::invariant_view, object}.
+
+@code
+namespace boost { namespace contract {
+    template<>
+    class invariant_view<table> { // Table protected by shared mutex.
+    public:
+        explicit invariant_view(table const& t) : t_(t), lock_(t.mutex_) {}
+        table const& object() const { return t_; }
+        bool consistent() const { return true; }
+    private:
+        table const& t_;
+        boost::shared_lock<boost::shared_mutex> lock_;
+    };
+} }
+@endcode
+
+Views are not used for @c volatile public functions (their invariants are
+already declared @c const @c volatile to be checked on concurrently accessed
+objects).
+Views should not acquire locks held by the calling thread while contracts are
+checked (e.g., declare locks after @RefClass{boost::contract::check} objects in
+function bodies so they are released before exit invariants are checked).
+
+@see @RefSect{extras.invariant_read_views, Invariant Read Views}
+
+@tparam C   Class (without @c const and @c volatile qualifiers) of the
+            invariants.
+*/
+template<class C>
+class invariant_view { // Non-copyable (as *).
+public:
+    /**
+    Start reading the specified object.
+
+    @param obj  Object whose invariants are being checked.
+    */
+    explicit invariant_view(C const& obj) : obj_(obj) {}
+
+    /**
+    Return the object on which to check invariants.
+
+    @return The object passed to this view (or a snapshot of it for views that
+            take snapshots).
+    */
+    C const& object() const { return obj_; }
+
+    /**
+    Return whether the object read by this view was consistent.
+
+    This is called after invariants have been checked on this view.
+
+    @return @c true if invariants checked on this view are to be trusted,
+            @c false if they must be checked again on a new view.
+    */
+    bool consistent() const { return true; }
+
+/** @cond */
+private:
+    invariant_view(invariant_view const&);
+    invariant_view& operator=(invariant_view const&);
+
+    C const& obj_;
+/** @endcond */
+};
+
+} } // namespace
+
+#endif // #include guard
+
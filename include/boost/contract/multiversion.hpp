@@ -0,0 +1,200 @@
+
+#ifndef BOOST_CONTRACT_MULTIVERSION_HPP_
+#define BOOST_CONTRACT_MULTIVERSION_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Call either checked or unchecked versions of contracted functions, selected at
+run-time.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+    #include <atomic>
+#endif
+#include <string>
+#include <cstddef>
+
+/* PRIVATE */
+
+/** @cond */
+namespace boost { namespace contract {
+    namespace multiversion_ {
+        struct registry_traits;
+    }
+
+    namespace detail {
+        // Type-erased so lib does not depend on function types.
+        class multiversion_base : private boost::noncopyable {
+        public:
+            typedef void (*version_type)();
+
+            char const* name() const { return name_; }
+
+            bool checked() const BOOST_NOEXCEPT_OR_NOTHROW {
+                return current() == checked_;
+            }
+
+        protected:
+            BOOST_CONTRACT_DETAIL_DECLSPEC
+            multiversion_base(char const* name, version_type checked,
+                    version_type unchecked);
+
+            BOOST_CONTRACT_DETAIL_DECLSPEC
+            ~multiversion_base(); // Not polymorphic (so protected).
+
+            version_type current() const BOOST_NOEXCEPT_OR_NOTHROW {
+                #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+                    return current_.load(std::memory_order_relaxed);
+                #else
+                    return current_;
+                #endif
+            }
+
+        private:
+            friend struct boost::contract::multiversion_::registry_traits;
+
+            char const* name_;
+            version_type checked_;
+            version_type unchecked_;
+            #ifndef BOOST_NO_CXX11_HDR_ATOMIC
+                std::atomic<version_type> current_;
+            #else
+                version_type volatile current_; // Set under mutex.
+            #endif
+            multiversion_base* next_; // Registered as intrusive list.
+        };
+    }
+} } // namespace
+/** @endcond */
+
+/* CODE */
+
+namespace boost { namespace contract {
+
+/**
+Pointer to either the checked or the unchecked version of a contracted
+function, selected at run-time.
+
+The two versions are usually the instantiations of a function body template
+with a @c bool parameter that selects at compile-time whether contracts are
+checked (see <c>boost::contract::function(boost::true_type)</c> and
+<c>boost::contract::function(boost::false_type)</c>), so the unchecked version
+contains no contract code at all.
+The contracted function then calls the version currently pointed to by this
+object, for example:
+
+@code
+template<bool Checked>
+int f_(int x) {
+    boost::contract::check c = boost::contract::function(
+            boost::integral_constant<bool, Checked>())
+        .precondition(...)
+        ...
+    ;
+    ... // Function body.
+}
+
+boost::contract::multiversion<int (int)> const f_version("f",
+        &f_<true>, &f_<false>);
+
+int f(int x) { return f_version.get()(x); }
+@endcode
+
+Calling the unchecked version costs a single relaxed load and an indirect call
+(on compilers that support C++11 @c std::atomic), but no branch on whether
+contracts are checked and no contract code.
+Multiversion objects are registered by name like call sites (see
+@RefClass{boost::contract::call_site}), and they must be constructed before they
+are first called.
+
+@see @RefSect{extras.multiversioning, Multiversioning}
+
+@tparam F   Function type of the contracted function (e.g., @c int(int)).
+*/
+template<typename F>
+class multiversion
+    /** @cond */ : private boost::contract::detail::multiversion_base
+    /** @endcond */
+{
+public:
+    /**
+    Construct and register this multiversion object.
+
+    This points to the checked version unless a previous call to
+    @RefFunc{boost::contract::set_multiversion_checked} selected the unchecked
+    version for its name.
+
+    @param name         Name of this multiversion object (usually the name of
+                        the function, this must point to a string with static
+                        storage duration).
+    @param checked      Version of the function that checks contracts.
+    @param unchecked    Version of the function that does not check contracts.
+    */
+    multiversion(char const* name, F* checked, F* unchecked) :
+        boost::contract::detail::multiversion_base(name,
+            reinterpret_cast<version_type>(checked),
+            reinterpret_cast<version_type>(unchecked)
+        )
+    {}
+
+    /** Name of this multiversion object. */
+    char const* name() const { return multiversion_base::name(); }
+
+    /** Return @c true if this points to the checked version. */
+    bool checked() const BOOST_NOEXCEPT_OR_NOTHROW {
+        return multiversion_base::checked();
+    }
+
+    /**
+    Return the version of the function to call.
+
+    This is a single relaxed load (on compilers that support C++11
+    @c std::atomic) so it can be called every time the contracted function is
+    called.
+    */
+    F* get() const BOOST_NOEXCEPT_OR_NOTHROW {
+        return reinterpret_cast<F*>(current());
+    }
+};
+
+/**
+Select checked or unchecked versions of contracted functions.
+
+This applies to all registered multiversion objects with the specified name,
+and also to multiversion objects with that name that are registered later (so
+versions can be selected at process start, before their functions are called
+for the first time).
+Calls to this function are applied in order (so a later call overrides an
+earlier one).
+
+@b Throws: This can throw @c std::bad_alloc.
+
+@param name     Name of the multiversion objects (see
+                @RefClass{boost::contract::multiversion}).
+@param checked  @c true to call checked versions, @c false to call unchecked
+                versions.
+
+@return Number of registered multiversion objects named @p name.
+
+@see @RefSect{extras.multiversioning, Multiversioning}
+*/
+/** @cond */ BOOST_CONTRACT_DETAIL_DECLSPEC /** @endcond */
+std::size_t set_multiversion_checked(std::string const& name, bool checked);
+
+} } // namespace
+
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/multiversion.hpp>
+#endif
+
+#endif // #include guard
+
@@ -16,17 +16,22 @@ Handle old values.
 #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
     #include <boost/contract/detail/checking.hpp>
 #endif
+#include <boost/contract/detail/old_storage.hpp>
 #include <boost/contract/detail/operator_safe_bool.hpp>
 #include <boost/contract/detail/declspec.hpp>
 #include <boost/contract/detail/debug.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
 #include <boost/type_traits/is_copy_constructible.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/preprocessor/control/expr_iif.hpp>
 #include <boost/preprocessor/config/config.hpp>
 #include <queue>
+#include <new>
 
 #if !BOOST_PP_VARIADICS
 
@@ -166,6 +171,52 @@ template<> // Needed because `old_value` incomplete type when trait first used.
 struct is_old_value_copyable<old_value> : boost::true_type {};
 /** @endcond */
 
+/**
+Trait to take a snapshot of an old value that shares state with the value
+(copy-on-write).
+
+By default, the implementation of this trait simply returns the specified value
+so it is then copied by @c boost::contract::old_value_copy<T> using @c T's copy
+constructor.
+However, programmers can specialize this trait for copy-on-write types that can
+return a copy of their value that shares their state (e.g., via a reference
+counted pointer), and that really copies such state only when either the value
+or its snapshot is later mutated.
+Then old values of these types cost one real copy only on calls that actually
+mutate them (e.g., for read-heavy workloads).
+For example:
+
+@code
+namespace boost { namespace contract {
+    template<>
+    struct old_value_snapshot<cow_vector> {
+        static cow_vector take(cow_vector const& value) {
+            return value.share(); // Share state until mutated.
+        }
+    };
+} }
+@endcode
+
+This library will instantiate and use this trait only on old value types @c T
+that are copyable (i.e., for which
+<c>boost::contract::is_old_value_copyable<T>::value</c> is @c true), and only
+from the default implementation of @c boost::contract::old_value_copy<T>.
+
+@see    @RefSect{extras.old_value_snapshots__copy_on_write_,
+        Old Value Snapshots (Copy-on-Write)}
+*/
+template<typename T> // Used only if is_old_value_copyable<T>.
+struct old_value_snapshot {
+    /**
+    Return the value so it is then copied by
+    @c boost::contract::old_value_copy<T> (specializations of this trait return
+    instead a snapshot sharing the value state).
+
+    @param value The old value.
+    */
+    static T const& take(T const& value) { return value; }
+};
+
 /**
 Trait to copy an old value.
 
@@ -180,7 +231,9 @@ template<typename T>
 class old_value_copy {
 public:
     explicit old_value_copy(T const& old) :
-        old_(value) // One single copy of value using T's copy constructor.
+        // One single copy of value using T's copy constructor (or a
+        // snapshot if old_value_snapshot<T> is specialized).
+        old_(old_value_snapshot<T>::take(old))
     {}
 
     T const& old() const { return old_; }
@@ -206,11 +259,13 @@ struct old_value_copy {
     values.
     This ensures this library makes one and only one copy of old values (if they
     actually need to be copied).
+    That copy is a snapshot sharing the old value state for copy-on-write types
+    (see @c boost::contract::old_value_snapshot).
 
     @param old The old value to copy.
     */
-    explicit old_value_copy(T const& old) :
-            old_(old) {} // This makes the one single copy of T.
+    explicit old_value_copy(T const& old) : // This makes the one single copy
+            old_(old_value_snapshot<T>::take(old)) {} // of T (or snapshot).
 
     /**
     Return a (constant) reference to the old value that was copied.
@@ -226,6 +281,22 @@ private:
     T const old_;
 };
 
+/** @cond */
+namespace detail {
+    // Small trivially copyable old value copies stored in place (no heap).
+    template<typename T>
+    struct old_copy_inline : boost::mpl::and_<
+        boost::contract::is_old_value_copyable<T>,
+        old_inline<old_value_copy<T> >
+    > {};
+
+    template<typename T>
+    struct old_copy_storage {
+        typedef old_storage<old_value_copy<T>, old_copy_inline<T>::value> type;
+    };
+}
+/** @endcond */
+
 template<typename T>
 class old_ptr_if_copyable;
 
@@ -286,8 +357,8 @@ public:
             "old_ptr<T> requires T copyable (see is_old_value_copyable<T>), "
             "otherwise use old_ptr_if_copyable<T>"
         );
-        BOOST_CONTRACT_DETAIL_DEBUG(typed_copy_);
-        return typed_copy_->old();
+        BOOST_CONTRACT_DETAIL_DEBUG(typed_copy_.get());
+        return typed_copy_.get()->old();
     }
 
     /**
@@ -310,13 +381,13 @@ public:
             "old_ptr<T> requires T copyble (see is_old_value_copyable<T>), "
             "otherwise use old_ptr_if_copyable<T>"
         );
-        if(typed_copy_) return &typed_copy_->old();
+        if(typed_copy_.get()) return &typed_copy_.get()->old();
         return static_cast<T const*>(0); // Explicit cast avoids warning.
     }
 
     #ifndef BOOST_CONTRACT_DETAIL_DOXYGEN
         BOOST_CONTRACT_DETAIL_OPERATOR_SAFE_BOOL(old_ptr<T>,
-                !!typed_copy_)
+                !!typed_copy_.get())
     #else
         /**
         Check if this old value pointer is null or not.
@@ -331,12 +402,14 @@ public:
 
 /** @cond */
 private:
+    typedef typename boost::contract::detail::old_copy_storage<T>::type
+            storage_type;
+
     #ifndef BOOST_CONTRACT_NO_OLDS
-        explicit old_ptr(boost::shared_ptr<old_value_copy<T> > old)
-                : typed_copy_(old) {}
+        explicit old_ptr(storage_type const& old) : typed_copy_(old) {}
     #endif
 
-    boost::shared_ptr<old_value_copy<T> > typed_copy_;
+    storage_type typed_copy_;
 
     friend class old_pointer;
     friend class old_ptr_if_copyable<T>;
@@ -413,8 +486,8 @@ public:
             Constant Correctness}).
     */
     T const& operator*() const {
-        BOOST_CONTRACT_DETAIL_DEBUG(typed_copy_);
-        return typed_copy_->old();
+        BOOST_CONTRACT_DETAIL_DEBUG(typed_copy_.get());
+        return typed_copy_.get()->old();
     }
 
     /**
@@ -432,13 +505,13 @@ public:
             Constant Correctness}).
     */
     T const* const operator->() const {
-        if(typed_copy_) return &typed_copy_->old();
+        if(typed_copy_.get()) return &typed_copy_.get()->old();
         return static_cast<T const*>(0); // Explicit cast avoids warning.
     }
 
     #ifndef BOOST_CONTRACT_DETAIL_DOXYGEN
         BOOST_CONTRACT_DETAIL_OPERATOR_SAFE_BOOL(old_ptr_if_copyable<T>,
-                !!typed_copy_)
+                !!typed_copy_.get())
     #else
         /**
         Check if this old value pointer is null or not (safe-bool operator).
@@ -453,17 +526,198 @@ public:
 
 /** @cond */
 private:
+    typedef typename boost::contract::detail::old_copy_storage<T>::type
+            storage_type;
+
     #ifndef BOOST_CONTRACT_NO_OLDS
-        explicit old_ptr_if_copyable(boost::shared_ptr<old_value_copy<T> > old)
+        explicit old_ptr_if_copyable(storage_type const& old)
                 : typed_copy_(old) {}
     #endif
 
-    boost::shared_ptr<old_value_copy<T> > typed_copy_;
+    storage_type typed_copy_;
 
     friend class old_pointer;
 /** @endcond */
 };
 
+/**
+Type of functors that reclaim old value copies.
+
+Old value reclaimer functors must be unary functors returning @c void and
+accepting a nullary functor that destroys and deallocates one old value copy
+when called (this nullary functor must be called exactly once, by any thread).
+Old value reclaimer functors should not throw (because they are called while
+releasing old value pointers).
+
+@see    @RefSect{advanced.old_value_reclamation, Old Value Reclamation}
+*/
+typedef boost::function<void (boost::function<void ()> const&)>
+        old_value_reclaimer;
+
+/** @cond */
+namespace old_ {
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    old_value_reclaimer const& set_reclaimer_unlocked(
+            old_value_reclaimer const& f);
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    old_value_reclaimer const& set_reclaimer_locked(
+            old_value_reclaimer const& f);
+
+    // Null if no reclaimer set (only to test if set, as pointed reclaimer can
+    // be freed once replaced unless pinned below).
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    old_value_reclaimer const* reclaimer_unlocked() BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    old_value_reclaimer const* reclaimer_locked() BOOST_NOEXCEPT_OR_NOTHROW;
+
+    // Null if no reclaimer set (pointed reclaimer never changes once set, and
+    // it is not freed even if replaced until unpinned).
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    old_value_reclaimer const* pin_reclaimer_unlocked()
+            BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    old_value_reclaimer const* pin_reclaimer_locked() BOOST_NOEXCEPT_OR_NOTHROW;
+
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void unpin_reclaimer_unlocked() BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void unpin_reclaimer_locked() BOOST_NOEXCEPT_OR_NOTHROW;
+
+    class pinned_reclaimer { // Reclaimer currently set, pinned while in scope.
+    public:
+        pinned_reclaimer() :
+            #ifndef BOOST_CONTRACT_DISABLE_THREADS
+                r_(pin_reclaimer_locked())
+            #else
+                r_(pin_reclaimer_unlocked())
+            #endif
+        {}
+
+        ~pinned_reclaimer() {
+            #ifndef BOOST_CONTRACT_DISABLE_THREADS
+                unpin_reclaimer_locked();
+            #else
+                unpin_reclaimer_unlocked();
+            #endif
+        }
+
+        old_value_reclaimer const* get() const { return r_; }
+
+    private:
+        pinned_reclaimer(pinned_reclaimer const&);
+        pinned_reclaimer& operator=(pinned_reclaimer const&);
+
+        old_value_reclaimer const* r_;
+    };
+}
+/** @endcond */
+
+/**
+Set the reclaimer of old value copies.
+
+By default, old value copies are destroyed and deallocated by the thread that
+releases the last old value pointer to them (usually when the function
+declaring the old value pointers returns).
+If a non-empty reclaimer is set, old value copies made from then on are instead
+passed to the reclaimer when released, so their destruction can be deferred or
+moved to another thread (for example, to remove large deallocations from the
+latency of function calls).
+Setting an empty reclaimer restores the default behaviour.
+Reclaimers replaced by later calls to this function are destroyed as soon as no
+release of old value copies is calling them.
+Old value copies stored in place within old value pointers (small trivially
+copyable types) have no destruction cost so they are never passed to the
+reclaimer.
+Memory of reclaimed copies is returned directly to the global
+<c>operator delete</c> instead of being recycled by later old value copies
+(because reclaimers usually release copies on threads that do not copy old
+values).
+
+@b Throws:  @c std::bad_alloc (or exceptions thrown copying @p f) if @p f
+            cannot be stored, in which case the previous reclaimer remains set.
+
+@param f New reclaimer functor to set.
+
+@return Same reclaimer functor @p f passed as parameter (e.g., for concatenating
+        function calls).
+
+@see    @RefSect{advanced.old_value_reclamation, Old Value Reclamation}
+*/
+inline old_value_reclaimer const& set_old_value_reclaimer(
+        old_value_reclaimer const& f) {
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        return old_::set_reclaimer_locked(f);
+    #else
+        return old_::set_reclaimer_unlocked(f);
+    #endif
+}
+
+/**
+Return the reclaimer of old value copies currently set (empty by default).
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@return A copy of the reclaimer currently set.
+
+@see    @RefSect{advanced.old_value_reclamation, Old Value Reclamation}
+*/
+inline old_value_reclaimer get_old_value_reclaimer()
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    old_::pinned_reclaimer r;
+    return r.get() ? *r.get() : old_value_reclaimer();
+}
+
+/** @cond */
+namespace detail {
+    inline bool old_value_reclaimer_set() {
+        #ifndef BOOST_CONTRACT_DISABLE_THREADS
+            return boost::contract::old_::reclaimer_locked();
+        #else
+            return boost::contract::old_::reclaimer_unlocked();
+        #endif
+    }
+
+    template<class C>
+    class old_reclaim { // Nullary functor passed to reclaimer.
+    public:
+        explicit old_reclaim(C* p) : p_(p) {}
+
+        // Reclaiming thread (e.g., background) does not copy old values, so
+        // block not cached in its free lists (it would never be recycled).
+        void operator()() const {
+            p_->~C();
+            old_allocator<C>().release(p_, 1);
+        }
+
+    private:
+        C* p_;
+    };
+
+    template<class C>
+    struct old_reclaim_deleter { // Called on last release of old value copy.
+        void operator()(C* p) const BOOST_NOEXCEPT_OR_NOTHROW {
+            old_reclaim<C> reclaim(p);
+            boost::contract::old_::pinned_reclaimer r;
+            if(r.get()) (*r.get())(reclaim); // Reclaimer should not throw.
+            else reclaim(); // Reclaimer reset since copy was made.
+        }
+    };
+
+    // Separate copy and ref count allocations (so copy can outlive count).
+    template<class C, typename T>
+    typename old_shared_ptr<C>::type allocate_reclaimed_old(T const& old) {
+        C* p = old_allocator<C>().allocate(1);
+        try { ::new(static_cast<void*>(p)) C(old); }
+        catch(...) {
+            old_allocator<C>().deallocate(p, 1);
+            throw;
+        }
+        return typename old_shared_ptr<C>::type(p, old_reclaim_deleter<C>(),
+                old_allocator<C>());
+    }
+}
+/** @endcond */
+
 /**
 Convert user-specified expressions to old values.
 
@@ -490,6 +744,10 @@ public:
     @c boost::contract::old_value_copy, in which case related old value pointer
     will not be null (no copy is made if postconditions and exception guarantees
     are not being checked, see @RefMacro{BOOST_CONTRACT_NO_OLDS}).
+    Small trivially copyable copies (sizes, counters, etc.) are stored in place
+    within the old value pointer (no heap allocation and no reference count),
+    other copies and their reference counts are allocated together in one
+    single memory block that is recycled (per thread) by later old value copies.
 
     @param old Old value to be copied.
 
@@ -506,9 +764,13 @@ public:
                 >::type* = 0
     )
         #ifndef BOOST_CONTRACT_NO_OLDS
-            : untyped_copy_(new old_value_copy<T>(old))
+            : inlined_(false)
+        #endif
+    {
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            copy(old, boost::contract::detail::old_copy_inline<T>());
         #endif // Else, leave ptr_ null (thus no copy of T).
-    {}
+    }
     
     /**
     Construct this object from the specified old value when the old value type
@@ -528,14 +790,42 @@ public:
         T const& /* old */,
         typename boost::disable_if<boost::contract::is_old_value_copyable<T>
                 >::type* = 0
-    ) {} // Leave ptr_ null (thus no copy of T).
+    )
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            : inlined_(false)
+        #endif
+    {} // Leave ptr_ null (thus no copy of T).
 
 /** @cond */
 private:
-    explicit old_value() {}
-    
     #ifndef BOOST_CONTRACT_NO_OLDS
-        boost::shared_ptr<void> untyped_copy_; // Type erasure.
+        explicit old_value() : inlined_(false) {}
+
+        template<typename T>
+        void copy(T const& old, boost::mpl::false_ /* inline */) {
+            if(boost::contract::detail::old_value_reclaimer_set()) {
+                untyped_copy_ = boost::contract::detail::
+                        allocate_reclaimed_old<old_value_copy<T> >(old);
+            } else {
+                // One allocation (copy and ref count) recycled from pool.
+                untyped_copy_ = boost::contract::detail::allocate_old<
+                        old_value_copy<T> >(old);
+            }
+        }
+
+        template<typename T>
+        void copy(T const& old, boost::mpl::true_ /* inline */) {
+            // Make the one copy in place (old_value_copy trivially copyable).
+            ::new(static_cast<void*>(&inline_copy_)) old_value_copy<T>(old);
+            inlined_ = true;
+        }
+
+        // Type erasure.
+        boost::contract::detail::old_shared_ptr<void>::type untyped_copy_;
+        boost::contract::detail::old_inline_buffer inline_copy_;
+        bool inlined_;
+    #else
+        explicit old_value() {}
     #endif
 
     friend class old_pointer;
@@ -591,7 +881,7 @@ public:
 private:
     #ifndef BOOST_CONTRACT_NO_OLDS
         explicit old_pointer(virtual_* v, old_value const& old)
-            : v_(v), untyped_copy_(old.untyped_copy_) {}
+            : v_(v), copy_(old) {}
     #else
         explicit old_pointer(virtual_* /* v */, old_value const& /* old */) {}
     #endif
@@ -599,65 +889,71 @@ private:
     template<typename Ptr>
     Ptr get() {
         #ifndef BOOST_CONTRACT_NO_OLDS
+            typedef typename Ptr::storage_type storage_type;
             if(!boost::contract::is_old_value_copyable<typename
                     Ptr::element_type>::value) {
-                BOOST_CONTRACT_DETAIL_DEBUG(!untyped_copy_);
+                BOOST_CONTRACT_DETAIL_DEBUG(!copy_.untyped_copy_);
+                BOOST_CONTRACT_DETAIL_DEBUG(!copy_.inlined_);
                 return Ptr(); // Non-copyable so no old value and return null.
         #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
             } else if(!v_ && boost::contract::detail::checking::already()) {
                 return Ptr(); // Not checking (so return null).
         #endif
             } else if(!v_) {
-                BOOST_CONTRACT_DETAIL_DEBUG(untyped_copy_);
-                typedef old_value_copy<typename Ptr::element_type> copied_type;
-                boost::shared_ptr<copied_type> typed_copy = // Un-erase type.
-                        boost::static_pointer_cast<copied_type>(untyped_copy_);
-                BOOST_CONTRACT_DETAIL_DEBUG(typed_copy);
+                BOOST_CONTRACT_DETAIL_DEBUG(copy_.untyped_copy_ ||
+                        copy_.inlined_);
+                storage_type typed_copy(copy_.untyped_copy_, // Un-erase type.
+                        copy_.inline_copy_, copy_.inlined_);
+                BOOST_CONTRACT_DETAIL_DEBUG(typed_copy.get());
                 return Ptr(typed_copy);
             } else if(
                 v_->action_ == boost::contract::virtual_::push_old_init_copy ||
                 v_->action_ == boost::contract::virtual_::push_old_ftor_copy
             ) {
-                BOOST_CONTRACT_DETAIL_DEBUG(untyped_copy_);
-                std::queue<boost::shared_ptr<void> >& copies = v_->action_ ==
+                BOOST_CONTRACT_DETAIL_DEBUG(copy_.untyped_copy_ ||
+                        copy_.inlined_);
+                virtual_::old_copy_queue& copies = v_->action_ ==
                         boost::contract::virtual_::push_old_ftor_copy ?
                     v_->old_ftor_copies_
                 :
                     v_->old_init_copies_
                 ;
-                copies.push(untyped_copy_);
+                // Queued copies always shared (so in-place copies moved).
+                copies.push(storage_type::share(copy_.untyped_copy_,
+                        copy_.inline_copy_, copy_.inlined_));
                 return Ptr(); // Pushed (so return null).
             } else if(
                 boost::contract::virtual_::pop_old_init_copy(v_->action_) ||
                 v_->action_ == boost::contract::virtual_::pop_old_ftor_copy
             ) {
                 // Copy not null, but still pop it from the queue.
-                BOOST_CONTRACT_DETAIL_DEBUG(!untyped_copy_);
+                BOOST_CONTRACT_DETAIL_DEBUG(!copy_.untyped_copy_);
+                BOOST_CONTRACT_DETAIL_DEBUG(!copy_.inlined_);
 
-                std::queue<boost::shared_ptr<void> >& copies = v_->action_ ==
+                virtual_::old_copy_queue& copies = v_->action_ ==
                         boost::contract::virtual_::pop_old_ftor_copy ?
                     v_->old_ftor_copies_
                 :
                     v_->old_init_copies_
                 ;
-                boost::shared_ptr<void> untyped_copy = copies.front();
+                virtual_::old_copy_ptr untyped_copy = copies.front();
                 BOOST_CONTRACT_DETAIL_DEBUG(untyped_copy);
                 copies.pop();
 
-                typedef old_value_copy<typename Ptr::element_type> copied_type;
-                boost::shared_ptr<copied_type> typed_copy = // Un-erase type.
-                        boost::static_pointer_cast<copied_type>(untyped_copy);
-                BOOST_CONTRACT_DETAIL_DEBUG(typed_copy);
+                storage_type typed_copy(untyped_copy, // Un-erase type.
+                        copy_.inline_copy_, /* inlined = */ false);
+                BOOST_CONTRACT_DETAIL_DEBUG(typed_copy.get());
                 return Ptr(typed_copy);
             }
-            BOOST_CONTRACT_DETAIL_DEBUG(!untyped_copy_);
+            BOOST_CONTRACT_DETAIL_DEBUG(!copy_.untyped_copy_);
+            BOOST_CONTRACT_DETAIL_DEBUG(!copy_.inlined_);
         #endif
         return Ptr();
     }
 
     #ifndef BOOST_CONTRACT_NO_OLDS
         virtual_* v_;
-        boost::shared_ptr<void> untyped_copy_; // Type erasure.
+        old_value copy_; // Type erasure.
     #endif
     
     friend BOOST_CONTRACT_DETAIL_DECLSPEC
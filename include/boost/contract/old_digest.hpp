@@ -0,0 +1,235 @@
+
+#ifndef BOOST_CONTRACT_OLD_DIGEST_HPP_
+#define BOOST_CONTRACT_OLD_DIGEST_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Digest old values (instead of copying them).
+*/
+
+#include <boost/range/has_range_iterator.hpp>
+#include <boost/range/value_type.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/mpl/bool.hpp>
+#include <iterator>
+#include <cstddef>
+
+namespace boost { namespace contract {
+
+/**
+Digest of a value (number of elements and hash of all elements).
+
+Digests are small and trivially copyable so old values of this type are cheap
+to copy (they are stored in place within old value pointers).
+The hash of a digest is the sum of one term per element that depends on both
+the element hash and the element position, so a digest can be updated in
+constant time when one single element changes (see
+@RefFunc{boost::contract::unchanged_except}).
+
+@see    @RefSect{extras.old_value_digests, Old Value Digests}
+*/
+class digest { // Copyable (as *).
+public:
+    /** Construct the digest of no element. */
+    digest() : size_(0), hash_(0) {}
+
+    /**
+    Add one element at the end of the digested sequence.
+
+    @param element_hash Hash of the added element (e.g., from @c boost::hash).
+    */
+    void push_back(std::size_t element_hash) {
+        hash_ += term(element_hash, size_);
+        ++size_;
+    }
+
+    /**
+    Replace the element at the specified position of the digested sequence.
+
+    @param i            Position of the replaced element (less than size).
+    @param old_hash     Hash of the element that was at position @p i.
+    @param new_hash     Hash of the element now at position @p i.
+    */
+    void replace(std::size_t i, std::size_t old_hash, std::size_t new_hash) {
+        hash_ -= term(old_hash, i);
+        hash_ += term(new_hash, i);
+    }
+
+    /** Return the number of digested elements. */
+    std::size_t size() const { return size_; }
+
+    /** Return the hash of all digested elements. */
+    std::size_t hash() const { return hash_; }
+
+    /** Check if the two digests are equal. */
+    friend bool operator==(digest const& left, digest const& right) {
+        return left.size_ == right.size_ && left.hash_ == right.hash_;
+    }
+
+    /** Check if the two digests are not equal. */
+    friend bool operator!=(digest const& left, digest const& right) {
+        return !(left == right);
+    }
+
+/** @cond */
+private:
+    static std::size_t term(std::size_t element_hash, std::size_t i) {
+        std::size_t h = element_hash + (i + 1) * 0x9e3779b9u;
+        h ^= h >> 16; h *= 0x85ebca6bu; // Mix bits (so position matters).
+        h ^= h >> 13; h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    std::size_t size_;
+    std::size_t hash_;
+/** @endcond */
+};
+
+/**
+Trait to digest an old value.
+
+By default, the digest of a range (anything with @c boost::begin and
+@c boost::end, e.g., standard containers and strings) has one element per range
+element hashed using @c boost::hash, and the digest of any other type has one
+single element hashed using @c boost::hash.
+However, programmers can specialize this trait to digest old values using
+user-specific operations (e.g., a checksum already maintained by the type).
+The default implementation of this trait is equivalent to:
+
+@code
+template<typename T>
+struct old_value_digest {
+    explicit old_value_digest(T const& value) {
+        for(auto const& element : value) digest_.push_back(boost::hash_value(element));
+    }
+
+    boost::contract::digest const& old() const { return digest_; }
+
+private:
+    boost::contract::digest digest_;
+};
+@endcode
+
+@see    @RefSect{extras.old_value_digests, Old Value Digests}
+*/
+template<typename T>
+struct old_value_digest {
+    /**
+    Construct this object by digesting the specified value.
+
+    @param value The value to digest (this is not copied).
+    */
+    explicit old_value_digest(T const& value) {
+        init(value, boost::mpl::bool_<
+                boost::has_range_const_iterator<T>::value>());
+    }
+
+    /** Return the digest of the value. */
+    digest const& old() const { return digest_; }
+
+/** @cond */
+private:
+    void init(T const& value, boost::mpl::true_ /* range */) {
+        typedef typename boost::range_value<T>::type element_type;
+        boost::hash<element_type> hash;
+        for(typename boost::range_const_iterator<T>::type i =
+                boost::begin(value); i != boost::end(value); ++i) {
+            digest_.push_back(hash(*i));
+        }
+    }
+
+    void init(T const& value, boost::mpl::false_ /* range */) {
+        digest_.push_back(boost::hash<T>()(value));
+    }
+
+    digest digest_;
+/** @endcond */
+};
+
+/**
+Digest the specified value.
+
+This is typically used to program old values that capture a digest in place of
+a full copy of a (potentially large) value:
+
+@code
+boost::contract::old_ptr<boost::contract::digest> old_v =
+        BOOST_CONTRACT_OLDOF(boost::contract::digest_of(v));
+@endcode
+
+@see    @RefSect{extras.old_value_digests, Old Value Digests}
+
+@param value    Value to digest (using
+                @RefClass{boost::contract::old_value_digest}).
+
+@return The digest of @p value.
+*/
+template<typename T>
+digest digest_of(T const& value) {
+    return old_value_digest<T>(value).old();
+}
+
+/**
+Check if the specified value has the same digest as an old value.
+
+This is typically used in postconditions to check that a value was not changed
+by the function body (using time linear in the size of the value, but constant
+memory to hold the old value digest).
+
+@see    @RefSect{extras.old_value_digests, Old Value Digests}
+
+@param old      Old value digest (see @RefFunc{boost::contract::digest_of}).
+@param value    Current value.
+
+@return True if @p value digest is equal to @p old.
+*/
+template<typename T>
+bool unchanged(digest const& old, T const& value) {
+    return digest_of(value) == old;
+}
+
+/**
+Check if the specified range has the same digest as an old value except for the
+element at the specified position.
+
+This is typically used in postconditions to check that a function body changed
+at most one element of a range (the old value of that one element is usually
+also copied as an old value).
+This requires the default @RefClass{boost::contract::old_value_digest} for
+ranges.
+
+@see    @RefSect{extras.old_value_digests, Old Value Digests}
+
+@param old          Old value digest of the range (see
+                    @RefFunc{boost::contract::digest_of}).
+@param value        Current range.
+@param i            Position of the element that might have changed.
+@param old_element  Old value of the element at position @p i.
+
+@return True if @p value digest, after replacing its element at position @p i
+        with @p old_element, is equal to @p old.
+*/
+template<typename Range>
+bool unchanged_except(digest const& old, Range const& value, std::size_t i,
+        typename boost::range_value<Range>::type const& old_element) {
+    digest d = digest_of(value);
+    if(i >= d.size()) return false;
+    typename boost::range_const_iterator<Range>::type element =
+            boost::begin(value);
+    std::advance(element, i);
+    boost::hash<typename boost::range_value<Range>::type> hash;
+    d.replace(i, hash(*element), hash(old_element));
+    return d == old;
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -16,6 +16,7 @@ Overloads handle public functions that are static, virtual void, virtual non-voi
 #include <boost/contract/core/specify.hpp>
 #include <boost/contract/core/access.hpp>
 #include <boost/contract/core/virtual.hpp>
+#include <boost/contract/contract_policy.hpp>
 /** @cond */
 // Needed within macro expansions below instead of defined(...) (PRIVATE macro).
 #if !defined(BOOST_CONTRACT_NO_PUBLIC_FUNCTIONS) || \
@@ -132,6 +133,10 @@ have no static invariants.
 template<class Class>
 specify_precondition_old_postcondition_except<> public_function() {
     #if BOOST_CONTRACT_PUBLIC_FUNCTIONS_IMPL_
+        // No contract allocated (but same specify type, so order checked).
+        if(boost::contract::detail::contract_policy_none<Class>::value) {
+            return specify_precondition_old_postcondition_except<>(0);
+        }
         return specify_precondition_old_postcondition_except<>(
             new boost::contract::detail::static_public_function<Class>());
     #else
@@ -213,6 +218,10 @@ no invariants.
 template<class Class>
 specify_precondition_old_postcondition_except<> public_function(Class* obj) {
     #if BOOST_CONTRACT_PUBLIC_FUNCTIONS_IMPL_
+        // No contract allocated (but same specify type, so order checked).
+        if(boost::contract::detail::contract_policy_none<Class>::value) {
+            return specify_precondition_old_postcondition_except<>(0);
+        }
         return specify_precondition_old_postcondition_except<>(
             new boost::contract::detail::public_function<
                 boost::contract::detail::none,
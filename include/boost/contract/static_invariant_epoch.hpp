@@ -0,0 +1,166 @@
+
+#ifndef BOOST_CONTRACT_STATIC_INVARIANT_EPOCH_HPP_
+#define BOOST_CONTRACT_STATIC_INVARIANT_EPOCH_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Skip static invariants while static state has not changed since they were last
+checked.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/config.hpp>
+#if     !defined(BOOST_CONTRACT_DISABLE_THREADS) && \
+        !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+    #include <atomic>
+#endif
+
+namespace boost { namespace contract {
+
+/**
+Trait to cache (or not) static invariants of a class.
+
+By default, this trait is @c false so static invariants are checked at entry
+and exit of all constructors, destructors, public functions, and static public
+functions of the specified class.
+Programmers can specialize this trait to @c true for classes with expensive
+static invariants.
+Then this library skips checking the static invariants of the specified class
+while the process-wide static invariant epoch has not changed since these static
+invariants were last checked successfully, and code that changes static state
+must call @RefFunc{boost::contract::static_invariant_changed} to advance this
+epoch.
+
+@code
+namespace boost { namespace contract {
+    template<>
+    struct cache_static_invariant<registry> : boost::true_type {};
+} }
+@endcode
+
+Checking whether static invariants need to be checked again is lock-free on
+compilers that support C++11 @c std::atomic (otherwise it is locked unless
+@RefMacro{BOOST_CONTRACT_DISABLE_THREADS} is defined).
+
+@see @RefSect{extras.static_invariant_epochs, Static Invariant Epochs}
+
+@tparam C   Class (without @c const and @c volatile qualifiers) of the static
+            invariants.
+*/
+template<class C>
+struct cache_static_invariant : boost::false_type {};
+
+/** @cond */
+namespace static_invariant_epoch_ {
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    unsigned long current_unlocked() BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    unsigned long current_locked() BOOST_NOEXCEPT_OR_NOTHROW;
+
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void advance_unlocked() BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void advance_locked() BOOST_NOEXCEPT_OR_NOTHROW;
+
+    // For compilers without lock-free atomics.
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    bool checked_locked(unsigned long const& last, unsigned long& epoch)
+            BOOST_NOEXCEPT_OR_NOTHROW;
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void check_locked(unsigned long& last, unsigned long epoch)
+            BOOST_NOEXCEPT_OR_NOTHROW;
+}
+
+namespace detail {
+    template<class C, bool Cache = boost::contract::cache_static_invariant<C>::
+            value>
+    class static_invariant_cache { // Not cached, so always checked.
+    public:
+        static bool checked(unsigned long&) { return false; }
+        static void check(unsigned long) {}
+    };
+
+    template<class C>
+    class static_invariant_cache<C, true> {
+    public:
+        static bool checked(unsigned long& epoch) {
+            #ifdef BOOST_CONTRACT_DISABLE_THREADS
+                epoch = boost::contract::static_invariant_epoch_::
+                        current_unlocked() + 1;
+                return last::ref() == epoch;
+            #elif !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+                epoch = boost::contract::static_invariant_epoch_::
+                        current_locked() + 1;
+                return last::ref().load(std::memory_order_acquire) == epoch;
+            #else
+                return boost::contract::static_invariant_epoch_::
+                        checked_locked(last::ref(), epoch);
+            #endif
+        }
+
+        // Epoch read before checking (so checked again if changed since).
+        static void check(unsigned long epoch) {
+            #ifdef BOOST_CONTRACT_DISABLE_THREADS
+                last::ref() = epoch;
+            #elif !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+                last::ref().store(epoch, std::memory_order_release);
+            #else
+                boost::contract::static_invariant_epoch_::check_locked(
+                        last::ref(), epoch);
+            #endif
+        }
+
+    private:
+        // Epoch at which static inv of C last passed, plus 1 (0 if never).
+        struct last_tag;
+        typedef boost::contract::detail::static_local_var<last_tag,
+            #if     !defined(BOOST_CONTRACT_DISABLE_THREADS) && \
+                    !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+                std::atomic<unsigned long> // Zero-initialized (as static).
+            #else
+                unsigned long
+            #endif
+        > last;
+    };
+}
+/** @endcond */
+
+/**
+Advance the process-wide static invariant epoch (so cached static invariants are
+checked again).
+
+This must be called every time static state that might break static invariants
+of classes for which @RefClass{boost::contract::cache_static_invariant} is
+@c true is changed (including by constructors, destructors, public functions,
+and static public functions of these classes, before they return).
+This is lock-free on compilers that support C++11 @c std::atomic (otherwise it
+is locked unless @RefMacro{BOOST_CONTRACT_DISABLE_THREADS} is defined).
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@see @RefSect{extras.static_invariant_epochs, Static Invariant Epochs}
+*/
+inline void static_invariant_changed()
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        static_invariant_epoch_::advance_locked();
+    #else
+        static_invariant_epoch_::advance_unlocked();
+    #endif
+}
+
+} } // namespace
+
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/static_invariant_epoch.hpp>
+#endif
+
+#endif // #include guard
+
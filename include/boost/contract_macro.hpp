@@ -975,6 +975,81 @@ Disable Contract Compilation}).
     #define BOOST_CONTRACT_FUNCTION() /* nothing */
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Program contracts that can be completely disabled at compile-time for
+    (non-public) functions, and that are checked only if a compile-time
+    condition is true.
+
+    This is the same as @RefMacro{BOOST_CONTRACT_FUNCTION} but it is used in
+    function body templates with a @c bool parameter so their instantiations for
+    @c false contain no contract code at all (e.g., to call either the checked
+    or the unchecked instantiation via
+    @RefClass{boost::contract::multiversion}):
+
+    @code
+    template<bool Checked>
+    void f_(...) {
+        BOOST_CONTRACT_FUNCTION_IF(Checked)
+            BOOST_CONTRACT_PRECONDITION([&] { // Optional.
+                BOOST_CONTRACT_ASSERT(...);
+                ...
+            })
+            ...
+        ;
+
+        ... // Function body.
+    }
+
+    boost::contract::multiversion<void (...)> const f_version("f",
+            &f_<true>, &f_<false>);
+
+    void f(...) { f_version.get()(...); }
+    @endcode
+
+    Old values should be copied using @RefMacro{BOOST_CONTRACT_OLD} (old values
+    copied where old value pointers are declared are also copied by unchecked
+    instantiations).
+
+    @c BOOST_CONTRACT_FUNCTION_IF(checked) expands to code equivalent to the
+    following (note that no code is generated when
+    @RefMacro{BOOST_CONTRACT_NO_FUNCTIONS} is defined):
+
+    @code
+        #ifndef BOOST_CONTRACT_NO_FUNCTIONS
+            boost::contract::check internal_var = boost::contract::function(
+                    boost::integral_constant<bool, checked>())
+        #endif
+    @endcode
+
+    Where:
+
+    @arg    <c><b>checked</b></c> is an integral constant expression that is
+            @c true to check the contracts, @c false to not check them.
+    @arg    <c><b>internal_var</b></c> is a variable name internally generated
+            by this library (this name is unique but only on different line
+            numbers so this macro cannot be expanded multiple times on the same
+            line).
+
+    @see    @RefSect{extras.multiversioning, Multiversioning},
+            @RefSect{extras.disable_contract_compilation__macro_interface_,
+            Disable Contract Compilation}
+    */
+    #define BOOST_CONTRACT_FUNCTION_IF(checked)
+#elif !defined(BOOST_CONTRACT_NO_FUNCTIONS)
+    #include <boost/contract/function.hpp>
+    #include <boost/contract/check.hpp>
+    #include <boost/contract/detail/name.hpp>
+    #include <boost/type_traits/integral_constant.hpp>
+
+    #define BOOST_CONTRACT_FUNCTION_IF(checked) \
+        boost::contract::check BOOST_CONTRACT_DETAIL_NAME2(c, __LINE__) = \
+                boost::contract::function( \
+                        boost::integral_constant<bool, (checked)>())
+#else
+    #define BOOST_CONTRACT_FUNCTION_IF(checked) /* nothing */
+#endif
+
 #ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
     /**
     Program contracts that can be completely disabled at compile-time for static
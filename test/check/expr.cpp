@@ -0,0 +1,120 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test assertions and checks reporting operand values on failure.
+
+#include <boost/contract/check.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <string>
+
+struct not_printable {
+    bool operator==(not_printable const&) const { return false; }
+};
+
+int x = 10, max = 3;
+void pre() { BOOST_CONTRACT_ASSERT_EXPR(x < max); }
+
+void f() {
+    boost::contract::check c = boost::contract::function().precondition(&pre);
+}
+
+std::string failed_values;
+void throw_failure(boost::contract::from) { throw; }
+void save_check_failure() {
+    try { throw; }
+    catch(boost::contract::assertion_failure const& error) {
+        failed_values = error.values();
+    }
+}
+
+// Return values of failed assertion (or "pass" if assertion passed).
+#define ASSERT_VALUES(cond) \
+    try { \
+        BOOST_CONTRACT_ASSERT_EXPR(cond); \
+        failed_values = "pass"; \
+    } catch(boost::contract::assertion_failure const& error) { \
+        failed_values = error.values(); \
+    }
+
+// Expected values of failed assertion (assertions pass if not compiled).
+std::string failed(char const* values) {
+    #ifndef BOOST_CONTRACT_NO_ALL
+        return values;
+    #else
+        return "pass";
+    #endif
+}
+
+int main() {
+    std::string const s = "abc";
+    not_printable n;
+
+    ASSERT_VALUES(x < max)
+    BOOST_TEST_EQ(failed_values, failed("10 < 3"));
+    ASSERT_VALUES(x > max)
+    BOOST_TEST_EQ(failed_values, "pass");
+    ASSERT_VALUES((x + 1) == 12) // Parenthesized operands.
+    BOOST_TEST_EQ(failed_values, failed("11 == 12"));
+    ASSERT_VALUES(x + 1 < max) // Arithmetic operands (not parenthesized).
+    BOOST_TEST_EQ(failed_values, failed("11 < 3"));
+    ASSERT_VALUES(x * 2 == max - 1)
+    BOOST_TEST_EQ(failed_values, failed("20 == 2"));
+    ASSERT_VALUES(s != "abc")
+    BOOST_TEST_EQ(failed_values, failed("abc != abc"));
+    ASSERT_VALUES(x <= max)
+    BOOST_TEST_EQ(failed_values, failed("10 <= 3"));
+    ASSERT_VALUES(max >= x)
+    BOOST_TEST_EQ(failed_values, failed("3 >= 10"));
+    ASSERT_VALUES(n == n)
+    BOOST_TEST_EQ(failed_values, failed("? == ?"));
+    ASSERT_VALUES(x == max)
+    BOOST_TEST_EQ(failed_values, failed("10 == 3"));
+    ASSERT_VALUES(x)
+    BOOST_TEST_EQ(failed_values, "pass");
+    ASSERT_VALUES((x > 0 && x < max)) // Parenthesized, only overall value.
+    BOOST_TEST_EQ(failed_values, failed("false"));
+
+    try {
+        BOOST_CONTRACT_ASSERT_EXPR(x < max);
+    } catch(boost::contract::assertion_failure const& error) {
+        BOOST_TEST_EQ(error.code(), std::string("x < max"));
+        BOOST_TEST_EQ(std::string(error.what()).find(
+                "assertion \"x < max\" failed for \"10 < 3\": file"), 0u);
+    }
+
+    boost::contract::set_check_failure(&save_check_failure);
+    failed_values = "";
+    BOOST_CONTRACT_CHECK_EXPR(x != 10);
+    #ifndef BOOST_CONTRACT_NO_CHECKS
+        BOOST_TEST_EQ(failed_values, "10 != 10");
+    #else
+        BOOST_TEST_EQ(failed_values, "");
+    #endif
+    failed_values = "";
+    BOOST_CONTRACT_CHECK_EXPR(x + 1 < max);
+    #ifndef BOOST_CONTRACT_NO_CHECKS
+        BOOST_TEST_EQ(failed_values, "11 < 3");
+    #else
+        BOOST_TEST_EQ(failed_values, "");
+    #endif
+
+    boost::contract::set_precondition_failure(&throw_failure);
+    failed_values = "";
+    try { f(); }
+    catch(boost::contract::assertion_failure const& error) {
+        failed_values = error.values();
+    }
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(failed_values, "10 < 3");
+    #else
+        BOOST_TEST_EQ(failed_values, "");
+    #endif
+
+    return boost::report_errors();
+}
+
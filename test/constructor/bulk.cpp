@@ -0,0 +1,91 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test constructor contracts checked once for objects constructed in bulk.
+
+#include <boost/contract/bulk.hpp>
+#include <boost/contract/constructor.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config.hpp>
+#include <vector>
+
+struct a {
+    static int static_invs, invs, posts;
+
+    static void static_invariant() { ++static_invs; }
+    void invariant() const { ++invs; }
+
+    a() {
+        boost::contract::check c = boost::contract::constructor(this)
+            .postcondition(&a::post)
+        ;
+    }
+
+    static void post() { ++posts; }
+};
+int a::static_invs = 0, a::invs = 0, a::posts = 0;
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #define BOOST_CONTRACT_TEST_entry 1
+    #else
+        #define BOOST_CONTRACT_TEST_entry 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_exit 1
+    #else
+        #define BOOST_CONTRACT_TEST_exit 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        #define BOOST_CONTRACT_TEST_post 1
+    #else
+        #define BOOST_CONTRACT_TEST_post 0
+    #endif
+    #if     defined(BOOST_CONTRACT_DISABLE_THREADS) || \
+            !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+        #define BOOST_CONTRACT_TEST_each 0
+    #else // Each ctor contract also checked (no thread-local to defer them).
+        #define BOOST_CONTRACT_TEST_each 1
+    #endif
+    int const entry = BOOST_CONTRACT_TEST_entry;
+    int const exit = BOOST_CONTRACT_TEST_exit;
+    int const post = BOOST_CONTRACT_TEST_post;
+    int const each = BOOST_CONTRACT_TEST_each;
+    #undef BOOST_CONTRACT_TEST_entry
+    #undef BOOST_CONTRACT_TEST_exit
+    #undef BOOST_CONTRACT_TEST_post
+    #undef BOOST_CONTRACT_TEST_each
+    int const n = 10;
+
+    std::vector<a> v;
+    v.reserve(2 * n);
+    {
+        boost::contract::bulk_constructor<a> b;
+        BOOST_TEST_EQ(a::static_invs, entry);
+        BOOST_TEST_EQ(a::invs, 0);
+
+        for(int i = 0; i < n; ++i) v.push_back(a());
+        BOOST_TEST_EQ(a::static_invs, entry + each * n * (entry + exit));
+        BOOST_TEST_EQ(a::invs, each * n * exit);
+        BOOST_TEST_EQ(a::posts, each * n * post);
+
+        b.check(v.begin(), v.end());
+        BOOST_TEST_EQ(a::static_invs, entry + each * n * (entry + exit) + exit);
+        BOOST_TEST_EQ(a::invs, each * n * exit + n * exit);
+        BOOST_TEST_EQ(a::posts, each * n * post);
+    }
+
+    a::static_invs = a::invs = a::posts = 0;
+    // Not in bulk, so each ctor contract checked again.
+    for(int i = 0; i < n; ++i) v.push_back(a());
+    BOOST_TEST_EQ(a::static_invs, n * (entry + exit));
+    BOOST_TEST_EQ(a::invs, n * exit);
+    BOOST_TEST_EQ(a::posts, n * post);
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,34 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test constructor cannot use `.precondition(...)` also if policy checks none.
+
+#include <boost/contract/constructor.hpp>
+#include <boost/contract/contract_policy.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+struct a;
+
+namespace boost { namespace contract {
+    template<>
+    struct contract_policy<a> : boost::integral_constant<unsigned,
+            policy_none> {};
+} } // namespace
+
+struct a {
+    a() {
+        boost::contract::check c = boost::contract::constructor(this)
+            .precondition([] {}) // Error (must use constructor_precondition).
+        ;
+    }
+};
+
+int main() {
+    a aa;
+    return 0;
+}
+
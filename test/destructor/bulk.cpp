@@ -0,0 +1,120 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test destructor contracts checked once for objects destructed in bulk.
+
+#include <boost/contract/bulk.hpp>
+#include <boost/contract/destructor.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config.hpp>
+#include <vector>
+
+struct a {
+    static int static_invs, invs, posts;
+
+    static void static_invariant() { ++static_invs; }
+    void invariant() const { ++invs; }
+
+    ~a() {
+        boost::contract::check c = boost::contract::destructor(this)
+            .postcondition(&a::post)
+        ;
+    }
+
+    static void post() { ++posts; }
+};
+int a::static_invs = 0, a::invs = 0, a::posts = 0;
+
+struct b {
+    static bool ok;
+    static int posts;
+
+    void invariant() const { BOOST_CONTRACT_ASSERT(ok); }
+
+    ~b() {
+        boost::contract::check c = boost::contract::destructor(this)
+            .postcondition(&b::post)
+        ;
+    }
+
+    static void post() { ++posts; }
+};
+bool b::ok = true;
+int b::posts = 0;
+
+struct err {};
+void throw_err(boost::contract::from) { throw err(); }
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #define BOOST_CONTRACT_TEST_entry 1
+    #else
+        #define BOOST_CONTRACT_TEST_entry 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_exit 1
+    #else
+        #define BOOST_CONTRACT_TEST_exit 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        #define BOOST_CONTRACT_TEST_post 1
+    #else
+        #define BOOST_CONTRACT_TEST_post 0
+    #endif
+    #if     defined(BOOST_CONTRACT_DISABLE_THREADS) || \
+            !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+        #define BOOST_CONTRACT_TEST_each 0
+    #else // Each dtor contract also checked (no thread-local to defer them).
+        #define BOOST_CONTRACT_TEST_each 1
+    #endif
+    int const entry = BOOST_CONTRACT_TEST_entry;
+    int const exit = BOOST_CONTRACT_TEST_exit;
+    int const post = BOOST_CONTRACT_TEST_post;
+    int const each = BOOST_CONTRACT_TEST_each;
+    #undef BOOST_CONTRACT_TEST_entry
+    #undef BOOST_CONTRACT_TEST_exit
+    #undef BOOST_CONTRACT_TEST_post
+    #undef BOOST_CONTRACT_TEST_each
+    int const n = 10;
+
+    std::vector<a> v(2 * n);
+    a::static_invs = a::invs = a::posts = 0;
+    {
+        boost::contract::bulk_destructor<a> b(v.begin() + n, v.end());
+        BOOST_TEST_EQ(a::static_invs, entry);
+        BOOST_TEST_EQ(a::invs, n * entry);
+
+        v.erase(v.begin() + n, v.end());
+        BOOST_TEST_EQ(a::static_invs, entry + each * n * (entry + exit));
+        BOOST_TEST_EQ(a::invs, n * entry + each * n * entry);
+        BOOST_TEST_EQ(a::posts, each * n * post);
+    }
+    BOOST_TEST_EQ(a::static_invs, entry + each * n * (entry + exit) + exit);
+
+    a::static_invs = a::invs = a::posts = 0;
+    v.clear(); // Not in bulk, so each dtor contract checked again.
+    BOOST_TEST_EQ(a::static_invs, n * (entry + exit));
+    BOOST_TEST_EQ(a::invs, n * entry);
+    BOOST_TEST_EQ(a::posts, n * post);
+
+    // Entry inv failure throws from bulk, dtor contracts still resumed after.
+    boost::contract::set_entry_invariant_failure(&throw_err);
+    std::vector<b> w(n);
+    b::ok = false;
+    bool threw = false;
+    try { boost::contract::bulk_destructor<b> d(w.begin(), w.end()); }
+    catch(err const&) { threw = true; }
+    BOOST_TEST_EQ(threw, entry == 1);
+    b::ok = true;
+    b::posts = 0;
+    w.pop_back();
+    BOOST_TEST_EQ(b::posts, post);
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,74 @@
+
+// no #include guard
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test obj being checked by one thread checked by other threads only if
+// checking tracked per thread.
+
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config.hpp>
+#include <thread>
+
+struct a {
+    static std::thread::id main_id;
+    static bool spawned;
+    static int other_invs;
+
+    void invariant() const {
+        if(std::this_thread::get_id() != main_id) {
+            ++other_invs;
+            return;
+        }
+        if(spawned) return;
+        spawned = true;
+        // While this thread checks inv of this obj, other thread calls it.
+        std::thread t([this] { m(); });
+        t.join();
+    }
+
+    void m() const {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+};
+std::thread::id a::main_id;
+bool a::spawned = false;
+int a::other_invs = 0;
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #define BOOST_CONTRACT_TEST_entry 1
+    #else
+        #define BOOST_CONTRACT_TEST_entry 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_exit 1
+    #else
+        #define BOOST_CONTRACT_TEST_exit 0
+    #endif
+    #if     defined(BOOST_CONTRACT_THREAD_LOCAL_CHECKING) && \
+            !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+        #define BOOST_CONTRACT_TEST_other 1
+    #else // Checking state shared by all threads.
+        #define BOOST_CONTRACT_TEST_other 0
+    #endif
+    int const inv = BOOST_CONTRACT_TEST_entry + BOOST_CONTRACT_TEST_exit;
+    int const other = BOOST_CONTRACT_TEST_other;
+    #undef BOOST_CONTRACT_TEST_entry
+    #undef BOOST_CONTRACT_TEST_exit
+    #undef BOOST_CONTRACT_TEST_other
+
+    a::main_id = std::this_thread::get_id();
+    a aa;
+    aa.m();
+    BOOST_TEST_EQ(a::spawned, inv > 0);
+    BOOST_TEST_EQ(a::other_invs, other * inv);
+
+    return boost::report_errors();
+}
+
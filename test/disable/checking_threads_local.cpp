@@ -0,0 +1,11 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#ifndef BOOST_CONTRACT_THREAD_LOCAL_CHECKING
+    #error "build must define THREAD_LOCAL_CHECKING"
+#endif
+#include "checking_threads.hpp"
+
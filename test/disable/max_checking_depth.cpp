@@ -0,0 +1,118 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test nested contracts checked up to max depth (but not inv of same obj).
+
+#if BOOST_CONTRACT_MAX_CHECKING_DEPTH != 3
+    #error "build must define MAX_CHECKING_DEPTH=3"
+#endif
+#include <boost/contract/function.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+int posts = 0;
+
+int f(int n) {
+    int result;
+    boost::contract::check c = boost::contract::function()
+        .postcondition([&] {
+            ++posts;
+            // Recursion bounded by max depth (not infinite, not exponential).
+            if(n > 0) BOOST_CONTRACT_ASSERT(f(n - 1) == n - 1);
+        })
+    ;
+    return result = n;
+}
+
+struct a {
+    static int invs, pres;
+
+    void invariant() const {
+        ++invs;
+        // Nested contract of same obj (so its inv not checked again).
+        BOOST_CONTRACT_ASSERT(size() >= 0);
+    }
+
+    int size() const {
+        boost::contract::check c = boost::contract::public_function(this)
+            .precondition([&] { ++pres; })
+        ;
+        return 0;
+    }
+
+    void m() {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+};
+int a::invs = 0, a::pres = 0;
+
+struct b { // Composite object.
+    static int invs;
+
+    void invariant() const {
+        ++invs;
+        BOOST_CONTRACT_ASSERT(x.size() == 0); // Nested contract of other obj.
+    }
+
+    void m() {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+
+    a x;
+};
+int b::invs = 0;
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        #define BOOST_CONTRACT_TEST_post 1
+    #else
+        #define BOOST_CONTRACT_TEST_post 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        #define BOOST_CONTRACT_TEST_pre 1
+    #else
+        #define BOOST_CONTRACT_TEST_pre 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #define BOOST_CONTRACT_TEST_entry 1
+    #else
+        #define BOOST_CONTRACT_TEST_entry 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_exit 1
+    #else
+        #define BOOST_CONTRACT_TEST_exit 0
+    #endif
+    int const post = BOOST_CONTRACT_TEST_post;
+    int const pre = BOOST_CONTRACT_TEST_pre;
+    int const inv = BOOST_CONTRACT_TEST_entry + BOOST_CONTRACT_TEST_exit;
+    #undef BOOST_CONTRACT_TEST_post
+    #undef BOOST_CONTRACT_TEST_pre
+    #undef BOOST_CONTRACT_TEST_entry
+    #undef BOOST_CONTRACT_TEST_exit
+
+    BOOST_TEST_EQ(f(10), 10);
+    BOOST_TEST_EQ(posts, 3 * post); // At depth 0, 1, and 2 (not 3 and deeper).
+
+    a aa;
+    aa.m();
+    BOOST_TEST_EQ(a::invs, inv); // Entry and exit of m (not of nested size).
+    BOOST_TEST_EQ(a::pres, inv * pre); // Nested size pre still checked.
+
+    a::invs = a::pres = 0;
+    b bb;
+    bb.m();
+    BOOST_TEST_EQ(b::invs, inv);
+    // Nested x.size checks inv of x (at depth 1) which calls x.size again (at
+    // depth 2, without checking inv of x again).
+    BOOST_TEST_EQ(a::invs, inv * inv);
+    BOOST_TEST_EQ(a::pres, inv * (inv + 1) * pre);
+
+    return boost::report_errors();
+}
+
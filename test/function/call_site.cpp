@@ -0,0 +1,161 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contracts enabled and disabled per call site at run-time.
+
+#include <boost/contract/function.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/core/call_site.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <sstream>
+#include <string>
+
+unsigned checked = 0; // Count assertions checked.
+void pre() { ++checked; BOOST_CONTRACT_ASSERT(true); }
+void post() { ++checked; BOOST_CONTRACT_ASSERT(true); }
+
+void f() {
+    BOOST_CONTRACT_CALL_SITE(site, "f");
+    boost::contract::check c(site, boost::contract::function()
+        .precondition(&pre)
+        .postcondition(&post)
+    );
+}
+
+boost::contract::call_site g_site("a::g", __FILE__, __LINE__);
+
+struct a {
+    void invariant() const { ++checked; }
+
+    void g() {
+        boost::contract::check c(g_site, boost::contract::public_function(this)
+            .precondition(&pre)
+        );
+    }
+};
+
+struct counted { // Count old value copies.
+    static unsigned copies;
+    counted() {}
+    counted(counted const&) { ++copies; }
+};
+unsigned counted::copies = 0;
+
+counted value;
+
+// No OLDOF here so C++11 not required for this test.
+void copy_old(boost::contract::old_ptr<counted>& old_value) {
+    old_value = boost::contract::make_old(boost::contract::copy_old() ?
+            value : boost::contract::null_old());
+}
+
+void h() { // Old value copied by .old(...), so not when site disabled.
+    boost::contract::old_ptr<counted> old_value;
+    BOOST_CONTRACT_CALL_SITE(site, "h");
+    boost::contract::check c(site, boost::contract::function()
+        .old(boost::bind(&copy_old, boost::ref(old_value)))
+        .postcondition(&post)
+    );
+}
+
+void h_at_body() { // Old value copied at body, so even when site disabled.
+    boost::contract::old_ptr<counted> old_value;
+    copy_old(old_value);
+    BOOST_CONTRACT_CALL_SITE(site, "h_at_body");
+    boost::contract::check c(site, boost::contract::function()
+        .postcondition(&post)
+    );
+}
+
+// Return number of assertions checked by calling f().
+unsigned checked_f() { checked = 0; f(); return checked; }
+unsigned checked_g() { a aa; checked = 0; aa.g(); return checked; }
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        unsigned const pre_checked = 1;
+    #else
+        unsigned const pre_checked = 0;
+    #endif
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        unsigned const post_checked = 1;
+    #else
+        unsigned const post_checked = 0;
+    #endif
+    #ifndef BOOST_CONTRACT_NO_INVARIANTS
+        unsigned const inv_checked = 2; // At entry and exit.
+    #else
+        unsigned const inv_checked = 0;
+    #endif
+
+    // Site of f not registered yet (as not called yet), still disabled.
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled("f", false), 0u);
+    BOOST_TEST_EQ(checked_f(), 0u);
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled("f", true), 1u);
+    BOOST_TEST_EQ(checked_f(), pre_checked + post_checked);
+
+    BOOST_TEST_EQ(checked_g(), pre_checked + inv_checked);
+    std::ostringstream g_file_line;
+    g_file_line << "call_site.cpp:" << g_site.line();
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled(g_file_line.str(),
+            false), 1u);
+    BOOST_TEST(!g_site.enabled());
+    BOOST_TEST_EQ(checked_g(), 0u);
+    BOOST_TEST_EQ(checked_f(), pre_checked + post_checked); // f still enabled.
+
+    // File must match at path separator.
+    g_file_line.str("");
+    g_file_line << "all_site.cpp:" << g_site.line();
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled(g_file_line.str(),
+            true), 0u);
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled("a::g", true), 1u);
+    BOOST_TEST_EQ(checked_g(), pre_checked + inv_checked);
+
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled("none", false), 0u);
+
+    { // Sites unregistered when destructed (e.g., by unloaded libraries).
+        boost::contract::call_site s("scoped", __FILE__, __LINE__);
+        BOOST_TEST_EQ(boost::contract::set_call_site_enabled("scoped", false),
+                1u);
+    }
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled("scoped", true), 0u);
+
+    // Setting same site again replaces its earlier setting, as last one.
+    for(int i = 0; i < 100; ++i) {
+        boost::contract::set_call_site_enabled("later", i % 2 != 0);
+    }
+    boost::contract::set_call_site_enabled("later.cpp:1", false);
+    boost::contract::set_call_site_enabled("later", true);
+    boost::contract::set_call_site_sampling("later", 3); // Not replacing above.
+    {
+        boost::contract::call_site s("later", "/src/later.cpp", 1);
+        BOOST_TEST(s.enabled());
+    }
+
+    h();
+    unsigned const copies = counted::copies; // Per old value copy (if any).
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        BOOST_TEST(copies > 0u);
+    #else
+        BOOST_TEST_EQ(copies, 0u);
+    #endif
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled("h", false), 1u);
+    counted::copies = 0;
+    for(int i = 0; i < 5; ++i) h();
+    BOOST_TEST_EQ(counted::copies, 0u);
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled("h_at_body", false),
+            0u);
+    counted::copies = 0;
+    for(int i = 0; i < 5; ++i) h_at_body();
+    BOOST_TEST_EQ(counted::copies, 5 * copies);
+    return boost::report_errors();
+}
+
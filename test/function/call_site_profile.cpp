@@ -0,0 +1,115 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contract checks and failures recorded and sampled per call site.
+
+#ifndef BOOST_CONTRACT_PROFILING
+    #error "build must define PROFILING"
+#endif
+#include <boost/contract/function.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/core/call_site.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <sstream>
+#include <string>
+
+bool ok = true;
+void pre() { BOOST_CONTRACT_ASSERT(ok); }
+void post() { BOOST_CONTRACT_ASSERT(true); }
+
+unsigned long f_line = 0;
+
+void f() {
+    f_line = __LINE__ + 1;
+    BOOST_CONTRACT_CALL_SITE(site, "f");
+    boost::contract::check c(site, boost::contract::function()
+        .precondition(&pre)
+        .postcondition(&post)
+    );
+}
+
+boost::contract::call_site g_site("g", __FILE__, __LINE__);
+
+void g() {
+    boost::contract::check c(g_site, boost::contract::function()
+        .precondition(&pre)
+    );
+}
+
+struct err {};
+void throw_err(boost::contract::from) { throw err(); }
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        boost::uint64_t const checked = 1;
+    #else
+        boost::uint64_t const checked = 0;
+    #endif
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        boost::uint64_t const pre_failed = 1;
+    #else
+        boost::uint64_t const pre_failed = 0;
+    #endif
+
+    boost::contract::set_precondition_failure(&throw_err);
+    g();
+    g();
+    BOOST_TEST_EQ(g_site.checks(), 2 * checked);
+    BOOST_TEST_EQ(g_site.failures(), 0u);
+    ok = false;
+    try { g(); } catch(err const&) {}
+    ok = true;
+    BOOST_TEST_EQ(g_site.checks(), 3 * checked);
+    BOOST_TEST_EQ(g_site.failures(), pre_failed);
+
+    // Disabled sites checked only when sampled.
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled("g", false), 1u);
+    BOOST_TEST_EQ(boost::contract::set_call_site_sampling("g", 2), 1u);
+    for(int i = 0; i < 4; ++i) g();
+    BOOST_TEST_EQ(g_site.checks(), 5 * checked);
+    BOOST_TEST_EQ(boost::contract::set_call_site_sampling("g", 0), 1u);
+    g();
+    BOOST_TEST_EQ(g_site.checks(), 5 * checked);
+
+    // Site of f not registered yet (as not called yet), still sampled.
+    BOOST_TEST_EQ(boost::contract::set_call_site_enabled("f", false), 0u);
+    BOOST_TEST_EQ(boost::contract::set_call_site_sampling("f", 3), 0u);
+    for(int i = 0; i < 3; ++i) f();
+
+    std::ostringstream profile;
+    boost::contract::write_call_site_profile(profile);
+    std::istringstream lines(profile.str());
+    std::string line;
+    BOOST_TEST(std::getline(lines, line) && line[0] == '#');
+
+    // Sorted by line (as same file).
+    std::ostringstream f_site, g_site_line;
+    f_site << __FILE__ << ":" << f_line;
+    g_site_line << __FILE__ << ":" << g_site.line();
+    std::string const names[] = {"f", "g"};
+    std::string const sites[] = {f_site.str(), g_site_line.str()};
+    boost::uint64_t const checks[] = {checked, 5 * checked};
+    boost::uint64_t const failures[] = {0, pre_failed};
+    for(int i = 0; i < 2; ++i) {
+        BOOST_TEST(std::getline(lines, line));
+        std::istringstream fields(line);
+        std::string name, site;
+        boost::uint64_t c = 0, f = 0, ns = 0;
+        std::getline(fields, name, '\t'); // Tab-separated.
+        std::getline(fields, site, '\t');
+        fields >> c >> f >> ns;
+        BOOST_TEST_EQ(name, names[i]);
+        BOOST_TEST_EQ(site, sites[i]);
+        BOOST_TEST_EQ(c, checks[i]);
+        BOOST_TEST_EQ(f, failures[i]);
+    }
+    BOOST_TEST(!std::getline(lines, line));
+    return boost::report_errors();
+}
+
@@ -0,0 +1,100 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test call site profile format read by boost_contract_profile-gen.py (names
+// and paths with spaces and tabs).
+
+#ifndef BOOST_CONTRACT_PROFILING
+    #error "build must define PROFILING"
+#endif
+#include <boost/contract/function.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/core/call_site.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+boost::contract::call_site f_site("f\tg h", "/src/a b.cpp", 12);
+boost::contract::call_site g_site(0, "/src/c.cpp", 3); // No name.
+
+void pre() { BOOST_CONTRACT_ASSERT(true); }
+
+void f() {
+    boost::contract::check c(f_site, boost::contract::function()
+        .precondition(&pre)
+    );
+}
+
+void g() {
+    boost::contract::check c(g_site, boost::contract::function()
+        .precondition(&pre)
+    );
+}
+
+// Split tab-separated fields and undo escapes (same as generator script).
+std::vector<std::string> fields(std::string const& line) {
+    std::vector<std::string> result(1);
+    for(std::string::size_type i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if(c == '\t') {
+            result.push_back("");
+            continue;
+        }
+        if(c == '\\' && i + 1 < line.size()) {
+            c = line[++i];
+            if(c == 't') c = '\t';
+            else if(c == 'n') c = '\n';
+        }
+        result.back() += c;
+    }
+    return result;
+}
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        unsigned const checked = 1;
+    #else
+        unsigned const checked = 0; // Not checked so not counted.
+    #endif
+
+    f();
+    f();
+    g();
+    std::ostringstream profile;
+    boost::contract::write_call_site_profile(profile);
+    std::istringstream lines(profile.str());
+    std::string line;
+
+    BOOST_TEST(std::getline(lines, line));
+    BOOST_TEST_EQ(line.substr(0, 1), "#"); // Comment skipped by generator.
+
+    std::vector<std::string> f_fields, g_fields;
+    while(std::getline(lines, line)) {
+        std::vector<std::string> const l = fields(line);
+        BOOST_TEST_EQ(l.size(), 5u); // Tabs in names escaped.
+        if(l.size() != 5) continue;
+        if(l[1] == "/src/a b.cpp:12") f_fields = l;
+        else if(l[1] == "/src/c.cpp:3") g_fields = l;
+    }
+
+    BOOST_TEST_EQ(f_fields.size(), 5u);
+    if(f_fields.size() == 5) {
+        BOOST_TEST_EQ(f_fields[0], "f\tg h");
+        BOOST_TEST_EQ(f_fields[2], checked ? "2" : "0");
+        BOOST_TEST_EQ(f_fields[3], "0");
+    }
+    BOOST_TEST_EQ(g_fields.size(), 5u);
+    if(g_fields.size() == 5) {
+        BOOST_TEST_EQ(g_fields[0], ""); // Empty first field (not stripped).
+        BOOST_TEST_EQ(g_fields[2], checked ? "1" : "0");
+        BOOST_TEST_EQ(g_fields[3], "0");
+    }
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,94 @@
+
+// no #include guard
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contracts of constexpr functions (at compile-time and run-time).
+
+#include <boost/contract/constexpr.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+constexpr int half(int x) { // C++11 constexpr (single return statement).
+    return BOOST_CONTRACT_CONSTEXPR_PRECONDITION(x >= 0),
+            BOOST_CONTRACT_CONSTEXPR_CHECK(x / 2 <= x),
+            x / 2;
+}
+
+constexpr int twice(int x) { // C++11 constexpr (single return statement).
+    return BOOST_CONTRACT_CONSTEXPR_POSTCONDITION(x * 2 >= x), x * 2;
+}
+
+constexpr int third(int x) { // Only check (to fail it without precondition).
+    return BOOST_CONTRACT_CONSTEXPR_CHECK(x / 3 <= x), x / 3;
+}
+
+struct err { char kind; };
+
+void throw_pre(boost::contract::from) { throw err{'p'}; }
+void throw_post(boost::contract::from) { throw err{'q'}; }
+void throw_check() { throw err{'c'}; }
+
+char failed(int (*f)(int), int x) {
+    try { f(x); }
+    catch(err const& e) { return e.kind; }
+    return 0;
+}
+
+#if defined(BOOST_CONTRACT_TEST_PRE_ERROR)
+    #ifdef BOOST_CONTRACT_NO_PRECONDITIONS
+        #error "force error if no preconditions (nothing to fail otherwise)"
+    #endif
+    constexpr int h = half(-2); // Failed precondition is compiler error.
+#elif defined(BOOST_CONTRACT_TEST_POST_ERROR)
+    #ifdef BOOST_CONTRACT_NO_POSTCONDITIONS
+        #error "force error if no postconditions (nothing to fail otherwise)"
+    #endif
+    constexpr int h = twice(-2); // Failed postcondition is compiler error.
+#elif defined(BOOST_CONTRACT_TEST_CHECK_ERROR)
+    #ifdef BOOST_CONTRACT_NO_CHECKS
+        #error "force error if no checks (nothing to fail otherwise)"
+    #endif
+    constexpr int h = third(-3); // Failed check is compiler error.
+#else
+    constexpr int h = half(4); // Passing contracts at compile-time.
+    static_assert(h == 2, "");
+    static_assert(twice(2) == 4, "");
+    static_assert(third(3) == 1, "");
+#endif
+
+int main() {
+    boost::contract::set_precondition_failure(&throw_pre);
+    boost::contract::set_postcondition_failure(&throw_post);
+    boost::contract::set_check_failure(&throw_check);
+
+    BOOST_TEST_EQ(h, 2);
+    BOOST_TEST_EQ(failed(&half, 4), 0);
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(failed(&half, -2), 'p'); // Failed at run-time.
+    #elif !defined(BOOST_CONTRACT_NO_CHECKS)
+        BOOST_TEST_EQ(failed(&half, -2), 'c'); // Check fails as -2 / 2 > -2.
+    #else
+        BOOST_TEST_EQ(failed(&half, -2), 0);
+    #endif
+
+    BOOST_TEST_EQ(failed(&twice, 2), 0);
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        BOOST_TEST_EQ(failed(&twice, -2), 'q'); // Failed at run-time.
+    #else
+        BOOST_TEST_EQ(failed(&twice, -2), 0);
+    #endif
+
+    BOOST_TEST_EQ(failed(&third, 3), 0);
+    #ifndef BOOST_CONTRACT_NO_CHECKS
+        BOOST_TEST_EQ(failed(&third, -3), 'c'); // Failed at run-time.
+    #else
+        BOOST_TEST_EQ(failed(&third, -3), 0);
+    #endif
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,179 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contract domains checked at their own levels and with own handlers.
+
+#include <boost/contract/function.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/core/domain.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/config.hpp>
+
+namespace lib_new {
+    boost::contract::domain& contracts() {
+        static boost::contract::domain d("lib_new");
+        return d;
+    }
+
+    unsigned audited = 0;
+    bool expensive() { ++audited; return true; }
+
+    bool ok = true;
+    void pre() {
+        BOOST_CONTRACT_ASSERT(ok);
+        BOOST_CONTRACT_DOMAIN_ASSERT_AUDIT(contracts(), expensive());
+    }
+
+    void f() {
+        boost::contract::check c(contracts(), boost::contract::function()
+            .precondition(&pre)
+        );
+    }
+}
+
+namespace lib_old {
+    boost::contract::domain& contracts() {
+        static boost::contract::domain d("lib_old");
+        return d;
+    }
+
+    bool ok = true;
+    void pre() { BOOST_CONTRACT_ASSERT(ok); }
+
+    void f() {
+        boost::contract::check c(contracts(), boost::contract::function()
+            .precondition(&pre)
+        );
+    }
+
+    struct counted { // Count old value copies.
+        static unsigned copies;
+        counted() {}
+        counted(counted const&) { ++copies; }
+    };
+    unsigned counted::copies = 0;
+
+    counted value;
+
+    // No OLDOF here so C++11 not required for this test.
+    void copy_old(boost::contract::old_ptr<counted>& old_value) {
+        old_value = boost::contract::make_old(boost::contract::copy_old() ?
+                value : boost::contract::null_old());
+    }
+
+    void g() { // Old value copied by .old(...), so not when domain off.
+        boost::contract::old_ptr<counted> old_value;
+        boost::contract::check c(contracts(), boost::contract::function()
+            .old(boost::bind(&copy_old, boost::ref(old_value)))
+        );
+    }
+
+    void g_at_body() { // Old value copied at body, so even when domain off.
+        boost::contract::old_ptr<counted> old_value;
+        copy_old(old_value);
+        boost::contract::check c(contracts(), boost::contract::function());
+    }
+}
+
+struct err {
+    explicit err(char id) : id(id) {}
+    char id;
+};
+
+void throw_g(boost::contract::from) { throw err('g'); }
+void throw_n(boost::contract::from) { throw err('n'); }
+
+// Return id of handler called by failed precondition (0 if none).
+char new_failed() {
+    lib_new::ok = false;
+    char id = 0;
+    try { lib_new::f(); }
+    catch(err const& e) { id = e.id; }
+    lib_new::ok = true;
+    return id;
+}
+
+char old_failed() {
+    lib_old::ok = false;
+    char id = 0;
+    try { lib_old::f(); }
+    catch(err const& e) { id = e.id; }
+    lib_old::ok = true;
+    return id;
+}
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        char const g = 'g';
+        #if     defined(BOOST_CONTRACT_DISABLE_THREADS) || \
+                !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            char const n = 'n';
+        #else // Domain handlers ignored (as scoped handlers).
+            char const n = 'g';
+        #endif
+        unsigned const audit = 1;
+    #else
+        char const g = 0, n = 0;
+        unsigned const audit = 0;
+    #endif
+
+    boost::contract::set_precondition_failure(&throw_g);
+    // Domain lib_old not registered yet (as not used yet), still set.
+    BOOST_TEST_EQ(boost::contract::set_domain_level("lib_old",
+            boost::contract::domain_off), 0u);
+    lib_new::contracts(); // Register lib_new (at first use).
+    BOOST_TEST_EQ(boost::contract::set_domain_level("lib_new",
+            boost::contract::domain_audit), 1u);
+
+    BOOST_TEST_EQ(old_failed(), 0);
+    BOOST_TEST(!lib_old::contracts().enabled());
+    lib_old::counted::copies = 0;
+    lib_old::g();
+    BOOST_TEST_EQ(lib_old::counted::copies, 0u);
+    lib_old::g_at_body();
+    unsigned const copies = lib_old::counted::copies; // Per old value copy.
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        BOOST_TEST(copies > 0u);
+    #else
+        BOOST_TEST_EQ(copies, 0u);
+    #endif
+    BOOST_TEST_EQ(new_failed(), g);
+    lib_new::audited = 0;
+    lib_new::f();
+    BOOST_TEST_EQ(lib_new::audited, audit);
+
+    lib_new::contracts().set_level(boost::contract::domain_on);
+    lib_new::audited = 0;
+    lib_new::f();
+    BOOST_TEST_EQ(lib_new::audited, 0u); // No audits at on level.
+
+    lib_new::contracts().set_precondition_failure(&throw_n);
+    BOOST_TEST_EQ(new_failed(), n);
+    lib_old::contracts().set_level(boost::contract::domain_on);
+    BOOST_TEST_EQ(old_failed(), g); // Other domain uses process handlers.
+    lib_old::counted::copies = 0;
+    lib_old::g();
+    BOOST_TEST_EQ(lib_old::counted::copies, copies);
+
+    lib_new::contracts().set_precondition_failure(
+            boost::contract::from_failure_handler());
+    BOOST_TEST_EQ(new_failed(), g);
+
+    { // Domains unregistered when destructed (e.g., by unloaded libraries).
+        boost::contract::domain d("scoped");
+        BOOST_TEST_EQ(boost::contract::set_domain_level("scoped",
+                boost::contract::domain_off), 1u);
+    }
+    BOOST_TEST_EQ(boost::contract::set_domain_level("scoped",
+            boost::contract::domain_on), 0u);
+    return boost::report_errors();
+}
+
@@ -0,0 +1,134 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test failure events recorded in ring buffer and memory-mapped file.
+
+#include <boost/contract/core/failure_journal.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+    #include <thread>
+    #include <functional>
+#endif
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+struct err {};
+
+void throw_err(boost::contract::from) { throw err(); }
+void throw_err_check() { throw err(); }
+
+// Fail assertion at specified line (reported as precondition failure).
+void pre_failed(unsigned long line) {
+    try {
+        try {
+            throw boost::contract::assertion_failure(__FILE__, line, "x > 0");
+        } catch(...) {
+            boost::contract::precondition_failure(
+                    boost::contract::from_constructor);
+        }
+    } catch(err const&) {}
+}
+
+void check_failed() {
+    try {
+        try { throw boost::contract::assertion_failure(__FILE__, 123, "y"); }
+        catch(...) { boost::contract::check_failure(); }
+    } catch(err const&) {}
+}
+
+void test_events(std::vector<boost::contract::failure_event> const& e) {
+    BOOST_TEST_EQ(e.size(), 4u); // Only 4 most recent out of 6 failures.
+    if(e.size() != 4u) return;
+
+    for(unsigned i = 0; i < 3; ++i) {
+        BOOST_TEST_EQ(e[i].kind, boost::contract::failed_precondition);
+        BOOST_TEST_EQ(e[i].where, boost::contract::from_constructor);
+        if(i > 0) BOOST_TEST(e[i - 1].timestamp <= e[i].timestamp);
+    }
+    BOOST_TEST_EQ(e[3].kind, boost::contract::failed_check);
+    BOOST_TEST_EQ(e[3].where, boost::contract::from_function);
+    BOOST_TEST_EQ(e[0].thread, e[3].thread);
+
+    BOOST_TEST_EQ(e[0].line, 3u);
+    BOOST_TEST_EQ(e[1].line, 4u);
+    BOOST_TEST_EQ(e[2].line, 5u);
+    BOOST_TEST_EQ(e[3].line, 123u);
+    BOOST_TEST_EQ(std::strcmp(e[0].code, "x > 0"), 0);
+    BOOST_TEST_EQ(std::strcmp(e[3].code, "y"), 0);
+    BOOST_TEST_EQ(std::strcmp(e[0].file, __FILE__), 0);
+}
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+    std::size_t thread_hashes[4];
+
+    // Line identifies thread (to check events from other threads not mixed up).
+    void fail_many(unsigned long line) {
+        thread_hashes[line] = std::hash<std::thread::id>()(
+                std::this_thread::get_id());
+        for(int i = 0; i < 1000; ++i) pre_failed(line);
+    }
+
+    // Threads wrapping around to same slot concurrently (as capacity 1).
+    void test_threads() {
+        BOOST_TEST(boost::contract::start_failure_journal(1));
+        std::vector<std::thread> threads;
+        for(unsigned long line = 0; line < 4; ++line) {
+            threads.push_back(std::thread(&fail_many, line));
+        }
+        for(std::size_t i = 0; i < threads.size(); ++i) threads[i].join();
+
+        std::vector<boost::contract::failure_event> e =
+                boost::contract::failure_journal_events();
+        BOOST_TEST_EQ(e.size(), 1u);
+        if(e.size() == 1u) {
+            BOOST_TEST(e[0].line < 4u);
+            if(e[0].line < 4u) {
+                BOOST_TEST_EQ(e[0].thread, static_cast<boost::uint64_t>(
+                        thread_hashes[e[0].line]));
+            }
+            BOOST_TEST_EQ(std::strcmp(e[0].code, "x > 0"), 0);
+        }
+        boost::contract::stop_failure_journal();
+    }
+#endif
+
+int main() {
+    boost::contract::set_precondition_failure(&throw_err);
+    boost::contract::set_check_failure(&throw_err_check);
+
+    pre_failed(0); // Not recorded (journal not started yet).
+    BOOST_TEST(boost::contract::failure_journal_events().empty());
+
+    #ifdef BOOST_HAS_UNISTD_H
+        char const* const path = "failure_journal.tmp";
+    #else // No memory-mapped files.
+        char const* const path = 0;
+    #endif
+    BOOST_TEST(boost::contract::start_failure_journal(4, path));
+    for(unsigned long line = 1; line <= 5; ++line) pre_failed(line);
+    check_failed();
+    test_events(boost::contract::failure_journal_events());
+
+    boost::contract::stop_failure_journal();
+    BOOST_TEST(boost::contract::failure_journal_events().empty());
+    pre_failed(6); // Not recorded (journal stopped).
+
+    #ifdef BOOST_HAS_UNISTD_H
+        test_events(boost::contract::read_failure_journal(path)); // As crashed.
+        std::remove(path);
+    #endif
+    BOOST_TEST(boost::contract::read_failure_journal("no_such.tmp").empty());
+
+    #ifndef BOOST_NO_CXX11_HDR_THREAD
+        test_threads();
+    #endif
+
+    return boost::report_errors();
+}
+
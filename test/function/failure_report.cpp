@@ -0,0 +1,95 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test failure reports limited per call site (but handlers always called).
+
+#include <boost/contract/core/failure_report.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+    #include <thread>
+    #include <chrono>
+#endif
+
+struct err {};
+
+unsigned handled = 0;
+boost::contract::failure_report last;
+
+void report_and_throw(boost::contract::from) {
+    ++handled;
+    last = boost::contract::report_failure();
+    throw err();
+}
+
+// Fail assertion at specified line (returning if it was reported).
+bool failed(unsigned long line) {
+    try {
+        try {
+            throw boost::contract::assertion_failure(__FILE__, line, "ok");
+        } catch(...) {
+            boost::contract::precondition_failure(
+                    boost::contract::from_function);
+        }
+    } catch(err const&) { return last.report; }
+    BOOST_TEST(false); // Handler did not throw.
+    return true;
+}
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+    unsigned const interval_ms = 1000; // Generous, so no slow run crosses it.
+
+    // Sleep until just after next interval starts (intervals are aligned to
+    // steady clock epoch), so next failures are all within one interval.
+    void next_interval() {
+        unsigned const now_ms = static_cast<unsigned>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()
+            ).count() % interval_ms
+        );
+        std::this_thread::sleep_for(std::chrono::milliseconds(
+                interval_ms - now_ms + 1));
+    }
+#endif
+
+int main() {
+    boost::contract::set_precondition_failure(&report_and_throw);
+
+    for(unsigned i = 0; i < 5; ++i) BOOST_TEST(failed(1)); // No limit.
+    BOOST_TEST_EQ(last.suppressed, 0u);
+
+    boost::contract::set_failure_report_limit(2, 0); // Single interval.
+    BOOST_TEST(failed(10));
+    BOOST_TEST(failed(10));
+    handled = 0;
+    for(unsigned i = 0; i < 100; ++i) BOOST_TEST(!failed(10));
+    BOOST_TEST_EQ(handled, 100u); // Handled even if not reported.
+    BOOST_TEST_EQ(last.suppressed, 0u);
+
+    BOOST_TEST(failed(20)); // Other call sites reported independently.
+    BOOST_TEST(failed(20));
+    BOOST_TEST(!failed(20));
+
+    #ifndef BOOST_NO_CXX11_HDR_THREAD
+        boost::contract::set_failure_report_limit(1, interval_ms);
+        next_interval();
+        BOOST_TEST(failed(10)); // Reported in new interval...
+        BOOST_TEST_EQ(last.suppressed, 100u); // ...with count of suppressed.
+        BOOST_TEST(!failed(10));
+        next_interval();
+        BOOST_TEST(failed(10));
+        BOOST_TEST_EQ(last.suppressed, 1u);
+    #endif
+
+    boost::contract::set_failure_report_limit(0, 0); // Remove limit.
+    BOOST_TEST(failed(10));
+    BOOST_TEST(failed(20));
+
+    return boost::report_errors();
+}
+
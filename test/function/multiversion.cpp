@@ -0,0 +1,159 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test checked and unchecked versions of functions selected at run-time.
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/multiversion.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract_macro.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+
+boost::contract::test::detail::oteststream out;
+
+int const max = 10;
+
+template<bool Checked>
+int inc_(int& x) {
+    boost::contract::old_ptr<int> old_x;
+    int result;
+    boost::contract::check c = boost::contract::function(
+            boost::integral_constant<bool, Checked>())
+        .precondition([&] {
+            out << "inc::pre" << std::endl;
+            BOOST_CONTRACT_ASSERT(x < max);
+        })
+        .old([&] {
+            out << "inc::old" << std::endl;
+            old_x = BOOST_CONTRACT_OLDOF(x);
+        })
+        .postcondition([&] {
+            out << "inc::post" << std::endl;
+            BOOST_CONTRACT_ASSERT(x == *old_x + 1);
+            BOOST_CONTRACT_ASSERT(result == *old_x);
+        })
+    ;
+    out << "inc::body" << std::endl;
+    return result = x++;
+}
+
+boost::contract::multiversion<int (int&)> const inc_version("inc",
+        &inc_<true>, &inc_<false>);
+
+int inc(int& x) { return inc_version.get()(x); }
+
+template<bool Checked>
+void dec_(int& x) { // Using macro interface.
+    BOOST_CONTRACT_FUNCTION_IF(Checked)
+        BOOST_CONTRACT_PRECONDITION([&] {
+            out << "dec::pre" << std::endl;
+            BOOST_CONTRACT_ASSERT(x > 0);
+        })
+    ;
+    out << "dec::body" << std::endl;
+    --x;
+}
+
+void dec(int& x) {
+    static boost::contract::multiversion<void (int&)> const v("dec",
+            &dec_<true>, &dec_<false>); // Registered at first call.
+    v.get()(x);
+}
+
+struct err {};
+void throw_err(boost::contract::from) { throw err(); }
+
+int main() {
+    std::ostringstream ok;
+    boost::contract::set_precondition_failure(&throw_err);
+    // Select version of dec before it is registered.
+    BOOST_TEST_EQ(boost::contract::set_multiversion_checked("dec", false), 0u);
+
+    BOOST_TEST(inc_version.checked());
+    int x = 0;
+    out.str("");
+    BOOST_TEST_EQ(inc(x), 0);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "inc::pre" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            << "inc::old" << std::endl
+        #endif
+        << "inc::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            << "inc::post" << std::endl
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(x, 1);
+
+    BOOST_TEST_EQ(boost::contract::set_multiversion_checked("inc", false), 1u);
+    BOOST_TEST(!inc_version.checked());
+    out.str("");
+    BOOST_TEST_EQ(inc(x), 1);
+    ok.str(""); ok << "inc::body" << std::endl; // No contracts.
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(x, 2);
+
+    x = max;
+    bool failed = false;
+    try { inc(x); } // Pre not checked, so no failure.
+    catch(err const&) { failed = true; }
+    BOOST_TEST(!failed);
+
+    BOOST_TEST_EQ(boost::contract::set_multiversion_checked("inc", true), 1u);
+    x = max;
+    failed = false;
+    try { inc(x); }
+    catch(err const&) { failed = true; }
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST(failed);
+        BOOST_TEST_EQ(x, max);
+    #else
+        BOOST_TEST(!failed);
+    #endif
+
+    x = 0;
+    failed = false;
+    out.str("");
+    try { dec(x); } // Registered as unchecked, so no failure.
+    catch(err const&) { failed = true; }
+    BOOST_TEST(!failed);
+    ok.str(""); ok << "dec::body" << std::endl;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(x, -1);
+
+    BOOST_TEST_EQ(boost::contract::set_multiversion_checked("dec", true), 1u);
+    x = 1;
+    out.str("");
+    dec(x);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "dec::pre" << std::endl
+        #endif
+        << "dec::body" << std::endl
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(x, 0);
+
+    { // Unregistered when destructed (e.g., by unloaded libraries).
+        boost::contract::multiversion<void (int&)> v("scoped", &dec_<true>,
+                &dec_<false>);
+        BOOST_TEST_EQ(boost::contract::set_multiversion_checked("scoped",
+                false), 1u);
+    }
+    BOOST_TEST_EQ(boost::contract::set_multiversion_checked("scoped", true),
+            0u);
+
+    return boost::report_errors();
+}
+
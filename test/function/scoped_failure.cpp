@@ -0,0 +1,109 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test scoped failure handlers called instead of process-wide ones.
+
+#include <boost/contract/function.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config.hpp>
+
+struct err {
+    explicit err(char id) : id(id) {}
+    char id;
+};
+
+void throw_g(boost::contract::from) { throw err('g'); }
+void throw_g_check() { throw err('g'); }
+void throw_a(boost::contract::from) { throw err('a'); }
+void throw_b(boost::contract::from) { throw err('b'); }
+void throw_b_check() { throw err('b'); }
+
+void delegate(boost::contract::from where) { // Delegate to outer scopes.
+    boost::contract::precondition_failure(where);
+}
+
+char pre_failed() {
+    try {
+        boost::contract::precondition_failure(boost::contract::from_function);
+    } catch(err const& e) { return e.id; }
+    return 0;
+}
+
+char post_failed() {
+    try {
+        boost::contract::postcondition_failure(boost::contract::from_function);
+    } catch(err const& e) { return e.id; }
+    return 0;
+}
+
+char check_failed() {
+    try { boost::contract::check_failure(); }
+    catch(err const& e) { return e.id; }
+    return 0;
+}
+
+bool ok = true;
+void pre() { BOOST_CONTRACT_ASSERT(ok); }
+
+void f() {
+    boost::contract::check c = boost::contract::function().precondition(&pre);
+}
+
+int main() {
+    #if     defined(BOOST_CONTRACT_DISABLE_THREADS) || \
+            !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+        bool const scoped = true;
+    #else // Scoped handlers ignored (no thread-local to push them).
+        bool const scoped = false;
+    #endif
+
+    boost::contract::set_precondition_failure(&throw_g);
+    boost::contract::set_postcondition_failure(&throw_g);
+    boost::contract::set_check_failure(&throw_g_check);
+    BOOST_TEST_EQ(pre_failed(), 'g');
+
+    {
+        boost::contract::scoped_failure_handlers a;
+        a.set_precondition_failure(&throw_a);
+        BOOST_TEST_EQ(pre_failed(), scoped ? 'a' : 'g');
+        BOOST_TEST_EQ(post_failed(), 'g'); // Not set in any scope.
+
+        {
+            boost::contract::scoped_failure_handlers b;
+            b.set_postcondition_failure(&throw_b).set_check_failure(
+                    &throw_b_check);
+            BOOST_TEST_EQ(pre_failed(), scoped ? 'a' : 'g'); // Outer scope.
+            BOOST_TEST_EQ(post_failed(), scoped ? 'b' : 'g');
+            BOOST_TEST_EQ(check_failed(), scoped ? 'b' : 'g');
+
+            b.set_precondition_failure(&delegate); // Delegate to outer a.
+            BOOST_TEST_EQ(pre_failed(), scoped ? 'a' : 'g');
+            b.set_precondition_failure(&throw_b);
+            BOOST_TEST_EQ(pre_failed(), scoped ? 'b' : 'g');
+        }
+
+        BOOST_TEST_EQ(pre_failed(), scoped ? 'a' : 'g'); // b popped.
+        BOOST_TEST_EQ(post_failed(), 'g');
+        BOOST_TEST_EQ(check_failed(), 'g');
+
+        ok = false;
+        try {
+            f();
+            #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+                BOOST_TEST(false);
+            #endif
+        } catch(err const& e) { BOOST_TEST_EQ(e.id, scoped ? 'a' : 'g'); }
+        ok = true;
+    }
+
+    BOOST_TEST_EQ(pre_failed(), 'g'); // a popped.
+    
+    return boost::report_errors();
+}
+
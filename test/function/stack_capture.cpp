@@ -0,0 +1,82 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test call stacks captured by exceptions (and symbolized later).
+
+#include <boost/contract/function.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config.hpp>
+#include <string>
+#include <cstddef>
+
+bool ok = true;
+void pre() { BOOST_CONTRACT_ASSERT(ok); }
+
+void f() {
+    boost::contract::check c = boost::contract::function().precondition(&pre);
+}
+
+void throw_failure(boost::contract::from) { throw; }
+
+// Return number of return addresses captured by failed precondition.
+std::size_t failed_stack_size() {
+    ok = false;
+    try { f(); }
+    catch(boost::contract::assertion_failure const& error) {
+        ok = true;
+        BOOST_TEST(error.stack_size() <= 32u);
+        boost::contract::assertion_failure copy(error);
+        BOOST_TEST_EQ(copy.stack_size(), error.stack_size());
+        for(std::size_t i = 0; i < error.stack_size(); ++i) {
+            BOOST_TEST_EQ(copy.stack()[i], error.stack()[i]);
+        }
+        copy = error; // Self-contained stack copies (not shared with error).
+        BOOST_TEST_EQ(copy.stack_size(), error.stack_size());
+        BOOST_TEST(error.stack_size() == 0 || copy.stack() != error.stack());
+        if(error.stack_size() == 0) BOOST_TEST(!error.stack());
+
+        std::string const s = boost::contract::symbolize_stack(error.stack(),
+                error.stack_size());
+        std::size_t lines = 0;
+        for(std::size_t i = 0; i < s.size(); ++i) if(s[i] == '\n') ++lines;
+        BOOST_TEST_EQ(lines, error.stack_size());
+        return error.stack_size();
+    }
+    ok = true;
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST(false); // Precondition did not fail.
+    #endif
+    return 0;
+}
+
+int main() {
+    boost::contract::set_precondition_failure(&throw_failure);
+
+    BOOST_TEST(!boost::contract::get_stack_capture()); // Disabled by default.
+    BOOST_TEST_EQ(failed_stack_size(), 0u);
+
+    boost::contract::set_stack_capture(true);
+    BOOST_TEST(boost::contract::get_stack_capture());
+    #if     defined(__linux__) && defined(__GNUC__) && \
+            !defined(BOOST_CONTRACT_NO_PRECONDITIONS)
+        BOOST_TEST(failed_stack_size() > 0u); // f, main, etc.
+    #else // No unwinder (or no contract failure).
+        BOOST_TEST_EQ(failed_stack_size(), 0u);
+    #endif
+
+    boost::contract::set_stack_capture(false);
+    BOOST_TEST_EQ(failed_stack_size(), 0u);
+
+    boost::contract::bad_virtual_result_cast error("a", "b");
+    BOOST_TEST_EQ(error.stack_size(), 0u);
+    BOOST_TEST_EQ(boost::contract::symbolize_stack(error.stack(), 0), "");
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,13 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test exit invariants of const public functions checked by default.
+
+#ifdef BOOST_CONTRACT_NO_CONST_EXIT_INVARIANTS
+    #error "build must not define NO_CONST_EXIT_INVARIANTS"
+#endif
+#include "const_exit.hpp"
+
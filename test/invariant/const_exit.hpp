@@ -0,0 +1,96 @@
+
+// no #include guard
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test exit invariants of const public functions checked by policy.
+
+#include <boost/contract/invariant_policy.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+struct a {
+    static int static_invs, const_invs, cv_invs;
+
+    static void static_invariant() { ++static_invs; }
+    void invariant() const { ++const_invs; }
+    void invariant() const volatile { ++cv_invs; }
+
+    void m() {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+
+    void c() const {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+
+    void cv() const volatile {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+};
+int a::static_invs = 0, a::const_invs = 0, a::cv_invs = 0;
+
+struct r { // Read-mostly class.
+    static int const_invs;
+
+    void invariant() const { ++const_invs; }
+
+    void c() const {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+};
+int r::const_invs = 0;
+
+namespace boost { namespace contract {
+    template<>
+    struct check_const_exit_invariants<r> : boost::false_type {};
+} } // namespace
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #define BOOST_CONTRACT_TEST_entry 1
+    #else
+        #define BOOST_CONTRACT_TEST_entry 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_exit 1
+    #else
+        #define BOOST_CONTRACT_TEST_exit 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_CONST_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_const_exit BOOST_CONTRACT_TEST_exit
+    #else
+        #define BOOST_CONTRACT_TEST_const_exit 0
+    #endif
+    int const entry = BOOST_CONTRACT_TEST_entry;
+    int const exit = BOOST_CONTRACT_TEST_exit;
+    int const const_exit = BOOST_CONTRACT_TEST_const_exit;
+    #undef BOOST_CONTRACT_TEST_entry
+    #undef BOOST_CONTRACT_TEST_exit
+    #undef BOOST_CONTRACT_TEST_const_exit
+
+    a aa;
+    aa.m(); // Non-const always checked at exit.
+    BOOST_TEST_EQ(a::const_invs, entry + exit);
+    BOOST_TEST_EQ(a::static_invs, entry + exit);
+
+    a::const_invs = a::static_invs = 0;
+    aa.c(); // Const checked at exit depending on default policy.
+    BOOST_TEST_EQ(a::const_invs, entry + const_exit);
+    BOOST_TEST_EQ(a::static_invs, entry + exit); // Static always checked.
+
+    aa.cv(); // Volatile always checked at exit.
+    BOOST_TEST_EQ(a::cv_invs, entry + exit);
+
+    r rr;
+    rr.c(); // Never checked at exit (policy specialized for this class).
+    BOOST_TEST_EQ(r::const_invs, entry);
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,99 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test static invariants skipped while static invariant epoch not changed.
+
+#include <boost/contract/static_invariant_epoch.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/constructor.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+struct a {
+    static int static_invs;
+
+    static void static_invariant() { ++static_invs; }
+
+    a() {
+        boost::contract::check c = boost::contract::constructor(this);
+    }
+
+    void f() {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+
+    void g() {
+        boost::contract::check c = boost::contract::public_function(this);
+        ++count_;
+        boost::contract::static_invariant_changed(); // Changed static state.
+    }
+
+    static void s() {
+        boost::contract::check c = boost::contract::public_function<a>();
+    }
+
+private:
+    static int count_;
+};
+int a::static_invs = 0, a::count_ = 0;
+
+namespace boost { namespace contract {
+    template<>
+    struct cache_static_invariant<a> : boost::true_type {};
+} }
+
+struct u { // Not cached (so always checked).
+    static int static_invs;
+
+    static void static_invariant() { ++static_invs; }
+
+    void f() {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+};
+int u::static_invs = 0;
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #define BOOST_CONTRACT_TEST_entry 1
+    #else
+        #define BOOST_CONTRACT_TEST_entry 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_exit 1
+    #else
+        #define BOOST_CONTRACT_TEST_exit 0
+    #endif
+    int const entry = BOOST_CONTRACT_TEST_entry;
+    int const exit = BOOST_CONTRACT_TEST_exit;
+    #undef BOOST_CONTRACT_TEST_entry
+    #undef BOOST_CONTRACT_TEST_exit
+    int const once = entry || exit ? 1 : 0;
+
+    a aa; // Not checked yet, so checked (just once).
+    BOOST_TEST_EQ(a::static_invs, once);
+
+    a::static_invs = 0;
+    aa.f(); // Static state not changed, so not checked.
+    aa.f();
+    a::s();
+    a bb;
+    BOOST_TEST_EQ(a::static_invs, 0);
+
+    aa.g(); // Changed in body, so checked at exit (or next entry).
+    BOOST_TEST_EQ(a::static_invs, exit);
+    aa.f();
+    aa.f();
+    BOOST_TEST_EQ(a::static_invs, once);
+
+    u uu;
+    uu.f();
+    uu.f();
+    BOOST_TEST_EQ(u::static_invs, 2 * (entry + exit));
+
+    return boost::report_errors();
+}
+
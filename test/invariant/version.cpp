@@ -0,0 +1,244 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test entry invariants skipped for objects not changed since last checked.
+
+#include <boost/contract/invariant_version.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/constructor.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+class a : private boost::contract::invariant_version {
+    friend class boost::contract::access;
+
+public:
+    static int static_invs, const_invs, cv_invs;
+
+    static void static_invariant() { ++static_invs; }
+    void invariant() const { ++const_invs; }
+    void invariant() const volatile { ++cv_invs; }
+
+    a() : x_(0) {}
+
+    void m() {
+        boost::contract::check c = boost::contract::public_function(this);
+        ++x_;
+    }
+
+    int c() const {
+        boost::contract::check c = boost::contract::public_function(this);
+        return x_;
+    }
+
+    void v() volatile {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+
+    int& ref() { // Not contracted, but returns reference to state.
+        invariant_changed();
+        return x_;
+    }
+
+private:
+    int x_;
+};
+int a::static_invs = 0, a::const_invs = 0, a::cv_invs = 0;
+
+class b : public a {
+    friend class boost::contract::access;
+
+public:
+    static int const_invs;
+
+    void invariant() const { ++const_invs; }
+
+    void n() {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+};
+int b::const_invs = 0;
+
+struct u { // Does not use versions (so always checked).
+    static int const_invs;
+
+    void invariant() const { ++const_invs; }
+
+    void m() {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+};
+int u::const_invs = 0;
+
+class w : private boost::contract::invariant_version {
+    friend class boost::contract::access;
+
+public:
+    static int const_invs;
+
+    void invariant() const {
+        ++const_invs;
+        BOOST_CONTRACT_ASSERT(ok_);
+    }
+
+    w() : ok_(true) {}
+
+    void set(bool ok) const { // Changes mutable state (without version).
+        boost::contract::check c = boost::contract::public_function(this);
+        ok_ = ok;
+    }
+
+private:
+    mutable bool ok_;
+};
+int w::const_invs = 0;
+
+class d : private boost::contract::invariant_version {
+    friend class boost::contract::access;
+
+public:
+    void invariant() const { BOOST_CONTRACT_ASSERT(x_ >= 0); }
+
+    d() : x_(0) {}
+
+    void dec() {
+        boost::contract::check c = boost::contract::public_function(this);
+        --x_;
+    }
+
+private:
+    int x_;
+};
+
+class e : private boost::contract::invariant_version {
+    friend class boost::contract::access;
+
+public:
+    static int const_invs;
+
+    void invariant() const { ++const_invs; }
+
+    e() { boost::contract::check c = boost::contract::constructor(this); }
+
+    void m() {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+};
+int e::const_invs = 0;
+
+struct err {};
+void throw_err(boost::contract::from) { throw err(); }
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #define BOOST_CONTRACT_TEST_entry 1
+    #else
+        #define BOOST_CONTRACT_TEST_entry 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_exit 1
+    #else
+        #define BOOST_CONTRACT_TEST_exit 0
+    #endif
+    int const entry = BOOST_CONTRACT_TEST_entry;
+    int const exit = BOOST_CONTRACT_TEST_exit;
+    #undef BOOST_CONTRACT_TEST_entry
+    #undef BOOST_CONTRACT_TEST_exit
+    // Versions recorded only at exit, so entry checked again without exit.
+    int const reentry = exit ? 0 : entry;
+
+    a aa;
+    aa.m(); // Not checked yet, so check at entry.
+    BOOST_TEST_EQ(a::const_invs, entry + exit);
+    BOOST_TEST_EQ(a::static_invs, entry + exit);
+
+    a::const_invs = a::static_invs = 0;
+    aa.m(); // Not changed since checked at exit, so skip entry.
+    aa.m();
+    BOOST_TEST_EQ(a::const_invs, 2 * (reentry + exit));
+    BOOST_TEST_EQ(a::static_invs, 2 * (entry + exit)); // Static always checked.
+
+    a::const_invs = 0;
+    BOOST_TEST_EQ(aa.c(), 3);
+    BOOST_TEST_EQ(a::const_invs, reentry + exit);
+
+    a::const_invs = 0;
+    aa.ref() = 10; // Changed version.
+    BOOST_TEST_EQ(aa.c(), 10);
+    BOOST_TEST_EQ(a::const_invs, entry + exit);
+
+    a::const_invs = 0;
+    aa.v(); // Volatile invariants always checked.
+    aa.v();
+    BOOST_TEST_EQ(a::cv_invs, 2 * (entry + exit));
+    BOOST_TEST_EQ(a::const_invs, 0);
+
+    a cc(aa); // Copy not checked yet.
+    a::const_invs = 0;
+    cc.m();
+    BOOST_TEST_EQ(a::const_invs, entry + exit);
+    a::const_invs = 0;
+    cc = aa; // Assignment changed version.
+    cc.m();
+    BOOST_TEST_EQ(a::const_invs, entry + exit);
+
+    b bb; // Versions recorded separately for each class.
+    a::const_invs = 0;
+    bb.n();
+    bb.n();
+    BOOST_TEST_EQ(b::const_invs, entry + reentry + 2 * exit);
+    BOOST_TEST_EQ(a::const_invs, 0);
+    bb.m(); // Class a invariants not checked yet for this object.
+    bb.m();
+    BOOST_TEST_EQ(a::const_invs, entry + reentry + 2 * exit);
+    b::const_invs = 0;
+    bb.n(); // Class b invariants still recorded.
+    BOOST_TEST_EQ(b::const_invs, reentry + exit);
+
+    e ee; // Also recorded at constructor exit.
+    BOOST_TEST_EQ(e::const_invs, exit);
+    e::const_invs = 0;
+    ee.m(); // Not changed since constructed, so skip entry.
+    BOOST_TEST_EQ(e::const_invs, reentry + exit);
+
+    u uu;
+    uu.m();
+    uu.m();
+    BOOST_TEST_EQ(u::const_invs, 2 * (entry + exit));
+
+    // Exit inv failed, so entry inv checked again (recorded version cleared).
+    boost::contract::set_entry_invariant_failure(&throw_err);
+    boost::contract::set_exit_invariant_failure(&throw_err);
+    w ww;
+    ww.set(true);
+    w::const_invs = 0;
+    bool threw = false;
+    try { ww.set(false); } // Entry skipped, exit fails.
+    catch(err const&) { threw = true; }
+    BOOST_TEST_EQ(threw, exit == 1);
+    BOOST_TEST_EQ(w::const_invs, reentry + exit);
+    w::const_invs = 0;
+    threw = false;
+    try { ww.set(true); } // Entry checked again and fails (so exit skipped).
+    catch(err const&) { threw = true; }
+    BOOST_TEST_EQ(threw, entry == 1);
+    BOOST_TEST_EQ(w::const_invs, entry + exit > 0 ? 1 : 0);
+
+    // Body broke inv, so entry inv checked again and fails even without exit.
+    d dd;
+    threw = false;
+    try { dd.dec(); } // Entry passes (not recorded), exit fails.
+    catch(err const&) { threw = true; }
+    BOOST_TEST_EQ(threw, exit == 1);
+    threw = false;
+    try { dd.dec(); } // Entry fails (no version recorded by entry above).
+    catch(err const&) { threw = true; }
+    BOOST_TEST_EQ(threw, entry + exit > 0);
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,142 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test invariants checked on read views (retried while views not consistent).
+
+#include <boost/contract/invariant_view.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+class a { // Sequence lock (writers increment seq_).
+    friend class boost::contract::access;
+    friend class boost::contract::invariant_view<a>;
+
+public:
+    static int invs, views, races;
+    static bool torn, broken;
+
+    a() : seq_(0) {}
+
+    void f() const {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+
+private:
+    void invariant() const {
+        ++invs;
+        if(races > 0) { // Simulate writer racing with this read.
+            --races;
+            ++seq_;
+            BOOST_CONTRACT_ASSERT(!torn); // Torn state read while writing.
+        }
+        BOOST_CONTRACT_ASSERT(!broken);
+    }
+
+    mutable int seq_;
+};
+int a::invs = 0, a::views = 0, a::races = 0;
+bool a::torn = false, a::broken = false;
+
+namespace boost { namespace contract {
+    template<>
+    class invariant_view<a> {
+    public:
+        explicit invariant_view(a const& obj) : obj_(obj), seq_(obj.seq_) {
+            ++a::views;
+        }
+        a const& object() const { return obj_; }
+        bool consistent() const { return obj_.seq_ == seq_; }
+    
+    private:
+        a const& obj_;
+        int seq_;
+    };
+} }
+
+struct s { // Snapshot.
+    static s const* checked;
+
+    void invariant() const { checked = this; }
+
+    void f() {
+        boost::contract::check c = boost::contract::public_function(this);
+    }
+};
+s const* s::checked = 0;
+
+namespace boost { namespace contract {
+    template<>
+    class invariant_view<s> {
+    public:
+        explicit invariant_view(s const& obj) : copy_(obj) {}
+        s const& object() const { return copy_; }
+        bool consistent() const { return true; }
+
+    private:
+        s copy_;
+    };
+} }
+
+struct err {};
+void throw_err(boost::contract::from) { throw err(); }
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #define BOOST_CONTRACT_TEST_entry 1
+    #else
+        #define BOOST_CONTRACT_TEST_entry 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_exit 1
+    #else
+        #define BOOST_CONTRACT_TEST_exit 0
+    #endif
+    int const entry = BOOST_CONTRACT_TEST_entry;
+    int const exit = BOOST_CONTRACT_TEST_exit;
+    #undef BOOST_CONTRACT_TEST_entry
+    #undef BOOST_CONTRACT_TEST_exit
+    
+    a aa;
+    aa.f(); // No race, so each inv checked once.
+    BOOST_TEST_EQ(a::invs, entry + exit);
+    BOOST_TEST_EQ(a::views, entry + exit);
+
+    a::invs = a::views = 0;
+    a::races = 1;
+    aa.f(); // Raced, so checked again on new view.
+    BOOST_TEST_EQ(a::invs, entry + exit + (entry || exit ? 1 : 0));
+    BOOST_TEST_EQ(a::views, a::invs);
+
+    boost::contract::set_invariant_failure(&throw_err);
+
+    a::invs = a::views = 0;
+    a::races = 1;
+    a::torn = true; // Failed on inconsistent view (so not reported).
+    try {
+        aa.f();
+    } catch(err const&) { BOOST_TEST(false); }
+    BOOST_TEST_EQ(a::races, entry || exit ? 0 : 1);
+    a::torn = false;
+
+    a::races = 0;
+    a::broken = true; // Broken on consistent view (so failure).
+    bool failed = false;
+    try {
+        aa.f();
+    } catch(err const&) { failed = true; }
+    BOOST_TEST_EQ(failed, entry || exit);
+    a::broken = false;
+
+    s ss;
+    ss.f();
+    BOOST_TEST(s::checked != &ss); // Checked on snapshot.
+    BOOST_TEST_EQ(s::checked != 0, entry || exit);
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,132 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test old value digests (instead of old value copies).
+
+#include <boost/contract/old_digest.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <vector>
+#include <string>
+
+struct err {}; // Global decl so visible in MSVC10 lambdas.
+
+struct blob { // Already maintains its own checksum...
+    std::vector<char> data;
+    unsigned checksum;
+};
+
+namespace boost { namespace contract {
+    template<>
+    struct old_value_digest<blob> { // ...so digest just that.
+        explicit old_value_digest(blob const& value) {
+            digest_.push_back(value.checksum);
+        }
+
+        digest const& old() const { return digest_; }
+
+    private:
+        digest digest_;
+    };
+} } // namespace
+
+int sum(std::vector<int> const& v, bool bug = false) {
+    int result = 0;
+    boost::contract::old_ptr<boost::contract::digest> old_v =
+            BOOST_CONTRACT_OLDOF(boost::contract::digest_of(v));
+    boost::contract::check c = boost::contract::function()
+        .postcondition([&] {
+            BOOST_CONTRACT_ASSERT(boost::contract::unchanged(*old_v, v));
+        })
+    ;
+
+    for(unsigned i = 0; i < v.size(); ++i) result += v[i];
+    if(bug) const_cast<std::vector<int>&>(v).push_back(0);
+    return result;
+}
+
+void set(std::vector<int>& v, unsigned i, int x, int bug = -1) {
+    boost::contract::old_ptr<boost::contract::digest> old_v =
+            BOOST_CONTRACT_OLDOF(boost::contract::digest_of(v));
+    boost::contract::old_ptr<int> old_vi = BOOST_CONTRACT_OLDOF(v[i]);
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] {
+            BOOST_CONTRACT_ASSERT(i < v.size());
+        })
+        .postcondition([&] {
+            BOOST_CONTRACT_ASSERT(v[i] == x);
+            BOOST_CONTRACT_ASSERT(boost::contract::unchanged_except(*old_v, v,
+                    i, *old_vi));
+        })
+    ;
+
+    v[i] = x;
+    if(bug >= 0) v[bug] = -v[bug];
+}
+
+int main() {
+    boost::contract::set_postcondition_failure([] (boost::contract::from) {
+        throw err(); // Test no throw from dtor of check.
+    });
+
+    std::vector<int> v;
+    for(int i = 1; i <= 100; ++i) v.push_back(i);
+
+    BOOST_TEST_EQ(sum(v), 5050);
+    set(v, 10, -11);
+    BOOST_TEST_EQ(v[10], -11);
+    set(v, 10, -11); // Same value.
+    BOOST_TEST_EQ(v[10], -11);
+
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        #define BOOST_CONTRACT_TEST_post 1
+    #else
+        #define BOOST_CONTRACT_TEST_post 0
+    #endif
+
+    bool failed = false;
+    try { sum(v, /* bug = */ true); }
+    catch(err const&) { failed = true; }
+    BOOST_TEST_EQ(failed, BOOST_CONTRACT_TEST_post);
+    v.pop_back();
+
+    failed = false;
+    try { set(v, 20, 0, /* bug = */ 30); } // Changed also other element.
+    catch(err const&) { failed = true; }
+    BOOST_TEST_EQ(failed, BOOST_CONTRACT_TEST_post);
+    v[30] = -v[30];
+
+    #undef BOOST_CONTRACT_TEST_post
+
+    // Digests depend on element positions and sizes.
+    std::vector<int> a(2), b(2), c(3);
+    a[0] = 1; a[1] = 2;
+    b[0] = 2; b[1] = 1;
+    BOOST_TEST(boost::contract::digest_of(a) != boost::contract::digest_of(b));
+    BOOST_TEST(boost::contract::digest_of(a) == boost::contract::digest_of(a));
+    BOOST_TEST_EQ(boost::contract::digest_of(c).size(), 3u);
+    BOOST_TEST(boost::contract::digest_of(std::vector<int>()) !=
+            boost::contract::digest_of(c));
+    BOOST_TEST(boost::contract::unchanged(boost::contract::digest_of(
+            std::string("abc")), std::string("abc")));
+    BOOST_TEST(!boost::contract::unchanged(boost::contract::digest_of(
+            std::string("abc")), std::string("abd")));
+    BOOST_TEST_EQ(boost::contract::digest_of(123).size(), 1u);
+    BOOST_TEST(!boost::contract::unchanged_except(boost::contract::digest_of(a),
+            a, 2, 0)); // Out of range.
+
+    blob x, y;
+    x.checksum = y.checksum = 123;
+    y.data.push_back('a'); // Not digested (only checksum is).
+    BOOST_TEST(boost::contract::digest_of(x) == boost::contract::digest_of(y));
+    BOOST_TEST_EQ(boost::contract::digest_of(x).size(), 1u);
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,98 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test small trivially copyable old values are copied in place (no heap).
+
+#include <boost/contract/old.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <vector>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+
+unsigned allocs = 0;
+
+void* operator new(std::size_t size) {
+    ++allocs;
+    if(void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) BOOST_NOEXCEPT_OR_NOTHROW { std::free(p); }
+void operator delete(void* p, std::size_t) BOOST_NOEXCEPT_OR_NOTHROW {
+    std::free(p); // Sized (C++14) replaced too, so it matches new above.
+}
+
+template<typename T>
+boost::contract::old_ptr<T> copy(T const& x) {
+    // No OLDOF here so C++11 not required for this test.
+    return boost::contract::make_old(
+            boost::contract::copy_old() ? x : boost::contract::null_old());
+}
+
+struct point { int x, y; };
+
+// Trivially copyable but with user-specific old value copy...
+struct offset { int value; };
+
+namespace boost { namespace contract {
+    template<>
+    struct old_value_copy<offset> { // ...still used (and still in place).
+        explicit old_value_copy(offset const& old) {
+            old_.value = old.value + 1000;
+        }
+
+        offset const& old() const { return old_; }
+
+    private:
+        offset old_;
+    };
+} } // namespace
+
+int main() {
+    std::vector<int> v(3);
+    point p = {1, 2};
+    offset o = {3};
+
+    unsigned const before = allocs;
+    boost::contract::old_ptr<std::size_t> old_size = copy(v.size());
+    boost::contract::old_ptr<point> old_p = copy(p);
+    boost::contract::old_ptr_if_copyable<offset> old_o = copy(o);
+    boost::contract::old_ptr<point> old_q = old_p; // Copy in place too.
+    BOOST_TEST_EQ(allocs, before); // No heap for all the above.
+
+    v.push_back(4);
+    p.x = -1;
+    o.value = -3;
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        BOOST_TEST(old_size);
+        BOOST_TEST_EQ(*old_size, 3u);
+        BOOST_TEST(old_p);
+        BOOST_TEST_EQ(old_p->x, 1);
+        BOOST_TEST_EQ(old_p->y, 2);
+        BOOST_TEST(old_q);
+        BOOST_TEST_EQ(old_q->x, 1);
+        BOOST_TEST(old_o);
+        BOOST_TEST_EQ(old_o->value, 1003);
+    #else
+        BOOST_TEST(!old_size);
+        BOOST_TEST(!old_p);
+        BOOST_TEST(!old_q);
+        BOOST_TEST(!old_o);
+    #endif
+
+    boost::contract::old_ptr<std::vector<int> > old_v = copy(v);
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        BOOST_TEST(allocs > before); // Not trivially copyable (so heap).
+        BOOST_TEST_EQ(old_v->size(), 4u);
+    #endif
+
+    boost::contract::old_ptr<int> old_n; // Null in place.
+    BOOST_TEST(!old_n);
+    BOOST_TEST(!old_n.operator->());
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,150 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test memory held by contracts is accounted (old values, conditions, etc.).
+
+#ifndef BOOST_CONTRACT_MEMORY_ACCOUNTING
+    #error "build must define MEMORY_ACCOUNTING"
+#endif
+#include <boost/contract/core/memory.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/base_types.hpp>
+#include <boost/contract/override.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <string>
+
+boost::contract::memory_usage in_body; // Memory held while executing body.
+
+struct b {
+    virtual void push(std::string const& s, std::string& v,
+            boost::contract::virtual_* v_ = 0) {
+        boost::contract::old_ptr<std::string> old_v = BOOST_CONTRACT_OLDOF(v_,
+                v);
+        boost::contract::check c = boost::contract::public_function(v_, this)
+            .postcondition([&] {
+                BOOST_CONTRACT_ASSERT(v.size() == old_v->size() + s.size());
+            })
+        ;
+        v += s;
+        in_body = boost::contract::thread_memory_usage();
+    }
+};
+
+struct a
+    #define BASES public b
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    virtual void push(std::string const& s, std::string& v,
+            boost::contract::virtual_* v_ = 0) /* override */ {
+        boost::contract::old_ptr<std::string> old_v = BOOST_CONTRACT_OLDOF(v_,
+                v);
+        boost::contract::check c = boost::contract::public_function<
+                override_push>(v_, &a::push, this, s, v)
+            .postcondition([&] {
+                BOOST_CONTRACT_ASSERT(v.size() == old_v->size() + s.size());
+            })
+        ;
+        v += s;
+        in_body = boost::contract::thread_memory_usage();
+    }
+    BOOST_CONTRACT_OVERRIDE(push)
+};
+
+struct big { char data[256]; }; // Too large for Boost.Function buffer.
+
+void large_pre(std::string const& s) {
+    big x = big();
+    x.data[0] = 1;
+    boost::contract::check c = boost::contract::function()
+        .precondition([s, x] { // Captures by value (so large functor).
+            BOOST_CONTRACT_ASSERT(x.data[0] == 1);
+            BOOST_CONTRACT_ASSERT(!s.empty());
+        })
+    ;
+    in_body = boost::contract::thread_memory_usage();
+}
+
+int main() {
+    std::string const long_str(1000, 'x');
+
+    BOOST_TEST_EQ(boost::contract::thread_memory_usage().total(), 0);
+    BOOST_TEST_EQ(boost::contract::thread_memory_usage().peak(), 0);
+
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        #define BOOST_CONTRACT_TEST_old 1
+    #else
+        #define BOOST_CONTRACT_TEST_old 0
+    #endif
+    #if !defined(BOOST_CONTRACT_NO_PUBLIC_FUNCTIONS) || \
+            !defined(BOOST_CONTRACT_NO_FUNCTIONS)
+        #define BOOST_CONTRACT_TEST_cond 1
+    #else
+        #define BOOST_CONTRACT_TEST_cond 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        #define BOOST_CONTRACT_TEST_pre 1
+    #else
+        #define BOOST_CONTRACT_TEST_pre 0
+    #endif
+
+    b bb;
+    std::string v = long_str;
+    bb.push(long_str, v);
+    // Old value object only (not string chars allocated by string itself).
+    BOOST_TEST_EQ(in_body.old_values() >= int(sizeof(std::string)),
+            BOOST_CONTRACT_TEST_old);
+    BOOST_TEST_EQ(in_body.old_values() < 1000, true);
+    BOOST_TEST_EQ(in_body.conditions() > 0, BOOST_CONTRACT_TEST_cond);
+    BOOST_TEST_EQ(in_body.virtual_queues(), 0);
+    BOOST_TEST_EQ(in_body.callables(), 0); // Lambda captures by ref.
+    BOOST_TEST_EQ(in_body.total(), in_body.old_values() +
+            in_body.conditions());
+    BOOST_TEST_EQ(in_body.peak(), in_body.total());
+    // All released on return (but peak kept).
+    BOOST_TEST_EQ(boost::contract::thread_memory_usage().total(), 0);
+    BOOST_TEST_EQ(boost::contract::thread_memory_usage().peak(),
+            in_body.peak());
+
+    boost::contract::reset_thread_memory_peak();
+    BOOST_TEST_EQ(boost::contract::thread_memory_usage().peak(), 0);
+
+    a aa;
+    v = long_str;
+    aa.push(long_str, v); // Subcontracting (so also queues).
+    BOOST_TEST_EQ(in_body.old_values() >= 2 * int(sizeof(std::string)),
+            BOOST_CONTRACT_TEST_old);
+    BOOST_TEST_EQ(in_body.virtual_queues() > 0, BOOST_CONTRACT_TEST_old);
+    BOOST_TEST_EQ(boost::contract::thread_memory_usage().total(), 0);
+    BOOST_TEST(boost::contract::thread_memory_usage().peak() >=
+            in_body.total());
+
+    boost::contract::reset_thread_memory_peak();
+    large_pre(long_str);
+    BOOST_TEST_EQ(in_body.callables() >= int(sizeof(big)),
+            BOOST_CONTRACT_TEST_pre);
+    BOOST_TEST_EQ(boost::contract::thread_memory_usage().total(), 0);
+    BOOST_TEST_EQ(boost::contract::thread_memory_usage().callables(), 0);
+
+    // Process-wide high-water mark (this test uses one single thread).
+    BOOST_TEST_EQ(boost::contract::process_memory_usage().total(), 0);
+    BOOST_TEST(boost::contract::process_memory_usage().peak() >=
+            boost::contract::thread_memory_usage().peak());
+    BOOST_TEST_EQ(boost::contract::process_memory_usage().peak() > 0,
+            BOOST_CONTRACT_TEST_cond);
+
+    #undef BOOST_CONTRACT_TEST_old
+    #undef BOOST_CONTRACT_TEST_cond
+    #undef BOOST_CONTRACT_TEST_pre
+    return boost::report_errors();
+}
+
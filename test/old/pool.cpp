@@ -0,0 +1,135 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test old value copies of different sizes and alignments (recycled memory).
+
+#include "../detail/counter.hpp"
+#include <boost/contract/old.hpp>
+#include <boost/config.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#if !defined(BOOST_NO_CXX11_HDR_THREAD) && \
+        !defined(BOOST_NO_CXX11_LAMBDAS)
+    #include <thread>
+#endif
+#include <cstring>
+
+template<unsigned Size>
+struct bytes {
+    char data[Size];
+    explicit bytes(char c) { std::memset(data, c, Size); }
+    bool all(char c) const {
+        for(unsigned i = 0; i < Size; ++i) if(data[i] != c) return false;
+        return true;
+    }
+};
+
+struct BOOST_ALIGNMENT(64) aligned { int value; };
+
+template<typename T>
+boost::contract::old_ptr<T> copy(T const& x) {
+    // No OLDOF here so C++11 not required for this test.
+    return boost::contract::make_old(
+            boost::contract::copy_old() ? x : boost::contract::null_old());
+}
+
+template<unsigned Size>
+void test_bytes() {
+    for(char c = 'a'; c <= 'z'; ++c) {
+        bytes<Size> x(c);
+        boost::contract::old_ptr<bytes<Size> > old_x = copy(x);
+        std::memset(x.data, '?', Size);
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            BOOST_TEST(old_x);
+            BOOST_TEST(old_x->all(c));
+        #else
+            BOOST_TEST(!old_x);
+        #endif
+    }
+}
+
+struct x_tag; typedef boost::contract::test::detail::counter<x_tag, int> x_type;
+
+int main() {
+    test_bytes<1>();
+    test_bytes<24>();
+    test_bytes<250>(); // Around largest pooled size.
+    test_bytes<5000>(); // Not pooled.
+
+    {
+        aligned a;
+        a.value = 123;
+        boost::contract::old_ptr<aligned> old_a = copy(a);
+        a.value = -1;
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            BOOST_TEST(old_a);
+            #ifdef __cpp_aligned_new // Else, new not required to align this.
+                BOOST_TEST_EQ(reinterpret_cast<std::size_t>(
+                        old_a.operator->()) % 64, 0u);
+            #endif
+            BOOST_TEST_EQ(old_a->value, 123);
+        #endif
+    }
+
+    {
+        x_type x;
+        boost::contract::old_ptr<x_type> old_x2;
+        {
+            x.value = 1;
+            boost::contract::old_ptr<x_type> old_x1 = copy(x);
+            old_x2 = old_x1; // Copy old value pointer (outlives old_x1).
+        }
+        x.value = 2;
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            BOOST_TEST(old_x2);
+            BOOST_TEST_EQ(old_x2->value, 1);
+            BOOST_TEST_EQ(x_type::copies(), 1u);
+        #endif
+
+        for(int i = 0; i < 1000; ++i) {
+            x.value = i;
+            boost::contract::old_ptr<x_type> old_x = copy(x);
+            #ifndef BOOST_CONTRACT_NO_OLDS
+                BOOST_TEST_EQ(old_x->value, i);
+            #endif
+        }
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            BOOST_TEST_EQ(old_x2->value, 1); // Not reused while still held.
+            BOOST_TEST_EQ(x_type::copies(), 1001u);
+            BOOST_TEST_EQ(x_type::ctors() - x_type::dtors(), 2u); // x, old_x2.
+        #else
+            BOOST_TEST_EQ(x_type::ctors() - x_type::dtors(), 1u); // x only.
+        #endif
+    }
+    BOOST_TEST_EQ(x_type::ctors(), x_type::dtors()); // All released.
+
+    #if !defined(BOOST_NO_CXX11_HDR_THREAD) && \
+            !defined(BOOST_NO_CXX11_LAMBDAS)
+        {
+            x_type x;
+            x.value = 3;
+            boost::contract::old_ptr<x_type> old_x = copy(x);
+            // Released by thread other than the one that made the copy.
+            std::thread t([&old_x] {
+                old_x = boost::contract::old_ptr<x_type>();
+            });
+            t.join();
+            BOOST_TEST(!old_x);
+
+            x.value = 4;
+            std::thread u([&x] { // Copied and released by another thread.
+                boost::contract::old_ptr<x_type> old_y = copy(x);
+                #ifndef BOOST_CONTRACT_NO_OLDS
+                    BOOST_TEST_EQ(old_y->value, 4);
+                #endif
+            });
+            u.join();
+        }
+        BOOST_TEST_EQ(x_type::ctors(), x_type::dtors());
+    #endif
+
+    return boost::report_errors();
+}
+
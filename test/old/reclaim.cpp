@@ -0,0 +1,114 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test old value copies passed to reclaimer (deferred destruction).
+
+#include "../detail/counter.hpp"
+#include <boost/contract/function.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <vector>
+
+struct x_tag; typedef boost::contract::test::detail::counter<x_tag, int> x_type;
+
+void inc(x_type& x, int& n) {
+    boost::contract::old_ptr<x_type> old_x = BOOST_CONTRACT_OLDOF(x);
+    boost::contract::old_ptr<int> old_n = BOOST_CONTRACT_OLDOF(n); // In place.
+    boost::contract::check c = boost::contract::function()
+        .postcondition([&] {
+            BOOST_CONTRACT_ASSERT(x.value == old_x->value + 1);
+            BOOST_CONTRACT_ASSERT(n == *old_n + 1);
+        })
+    ;
+    ++x.value;
+    ++n;
+}
+
+std::vector<boost::function<void ()> > deferred;
+
+void reclaim(boost::function<void ()> const& destroy) {
+    deferred.push_back(destroy);
+}
+
+void drain() {
+    for(unsigned i = 0; i < deferred.size(); ++i) deferred[i]();
+    deferred.clear();
+}
+
+struct counted_reclaimer { // Count reclaimer copies still alive.
+    static unsigned alive;
+    counted_reclaimer() { ++alive; }
+    counted_reclaimer(counted_reclaimer const&) { ++alive; }
+    ~counted_reclaimer() { --alive; }
+
+    void operator()(boost::function<void ()> const& destroy) const {
+        // Replaced while called (so this must not be freed yet).
+        boost::contract::set_old_value_reclaimer(counted_reclaimer());
+        destroy();
+    }
+};
+unsigned counted_reclaimer::alive = 0;
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        #define BOOST_CONTRACT_TEST_old(x) x
+    #else
+        #define BOOST_CONTRACT_TEST_old(x) 0
+    #endif
+
+    x_type x;
+    int n = 0;
+    BOOST_TEST(!boost::contract::get_old_value_reclaimer());
+
+    inc(x, n); // No reclaimer (so copies destroyed on return).
+    BOOST_TEST_EQ(x.value, 1);
+    BOOST_TEST_EQ(x_type::copies(), BOOST_CONTRACT_TEST_old(1u));
+    BOOST_TEST_EQ(x_type::ctors() - x_type::dtors(), 1u); // Only x.
+    BOOST_TEST(deferred.empty());
+
+    boost::contract::set_old_value_reclaimer(&reclaim);
+    BOOST_TEST(boost::contract::get_old_value_reclaimer());
+    inc(x, n);
+    inc(x, n);
+    BOOST_TEST_EQ(x.value, 3);
+    BOOST_TEST_EQ(n, 3);
+    BOOST_TEST_EQ(x_type::copies(), BOOST_CONTRACT_TEST_old(3u));
+    // Only x_type copies deferred (int copies were in place).
+    BOOST_TEST_EQ(deferred.size(), BOOST_CONTRACT_TEST_old(2u));
+    BOOST_TEST_EQ(x_type::ctors() - x_type::dtors(),
+            1u + BOOST_CONTRACT_TEST_old(2u)); // Not destroyed yet.
+    drain();
+    BOOST_TEST_EQ(x_type::ctors() - x_type::dtors(), 1u);
+
+    {
+        boost::contract::old_ptr<x_type> old_x = BOOST_CONTRACT_OLDOF(x);
+        // Reclaimer reset after copy made (so destroyed on release).
+        boost::contract::set_old_value_reclaimer(
+                boost::contract::old_value_reclaimer());
+    }
+    BOOST_TEST(deferred.empty());
+    BOOST_TEST_EQ(x_type::ctors() - x_type::dtors(), 1u);
+
+    inc(x, n);
+    BOOST_TEST(deferred.empty());
+    BOOST_TEST_EQ(x_type::ctors() - x_type::dtors(), 1u);
+
+    for(unsigned i = 0; i < 100; ++i) { // Replaced ones not leaked.
+        boost::contract::set_old_value_reclaimer(counted_reclaimer());
+    }
+    BOOST_TEST_EQ(counted_reclaimer::alive, 1u); // Only one currently set.
+    inc(x, n); // Reclaimer sets another reclaimer while it is called.
+    BOOST_TEST_EQ(x_type::ctors() - x_type::dtors(), 1u);
+    boost::contract::set_old_value_reclaimer(
+            boost::contract::old_value_reclaimer());
+    BOOST_TEST_EQ(counted_reclaimer::alive, 0u);
+
+    #undef BOOST_CONTRACT_TEST_old
+    return boost::report_errors();
+}
+
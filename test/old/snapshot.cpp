@@ -0,0 +1,120 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test old value snapshots of copy-on-write types.
+
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <vector>
+
+// Deep copies by copy constructor, but can also share state until mutated.
+class cow_vector {
+public:
+    static unsigned deep_copies;
+
+    cow_vector() : data_(boost::make_shared<std::vector<int> >()) {}
+
+    cow_vector(cow_vector const& other) :
+            data_(boost::make_shared<std::vector<int> >(*other.data_)) {
+        ++deep_copies;
+    }
+
+    cow_vector share() const { return cow_vector(data_); }
+
+    std::size_t size() const { return data_->size(); }
+    int operator[](std::size_t i) const { return (*data_)[i]; }
+
+    void push_back(int x) {
+        detach();
+        data_->push_back(x);
+    }
+
+private:
+    explicit cow_vector(boost::shared_ptr<std::vector<int> > data) :
+            data_(data) {}
+
+    void detach() {
+        if(!data_.unique()) { // Copy on write.
+            data_ = boost::make_shared<std::vector<int> >(*data_);
+            ++deep_copies;
+        }
+    }
+
+    cow_vector& operator=(cow_vector const&) /* = delete */;
+
+    boost::shared_ptr<std::vector<int> > data_;
+};
+unsigned cow_vector::deep_copies = 0;
+
+namespace boost { namespace contract {
+    template<>
+    struct old_value_snapshot<cow_vector> {
+        static cow_vector take(cow_vector const& value) {
+            return value.share();
+        }
+    };
+} } // namespace
+
+struct a {
+    cow_vector v;
+
+    int front() const {
+        boost::contract::old_ptr<cow_vector> old_v = BOOST_CONTRACT_OLDOF(v);
+        boost::contract::check c = boost::contract::public_function(this)
+            .postcondition([&] {
+                BOOST_CONTRACT_ASSERT(v.size() == old_v->size());
+            })
+        ;
+        return v[0];
+    }
+
+    void push_back(int x) {
+        boost::contract::old_ptr<cow_vector> old_v = BOOST_CONTRACT_OLDOF(v);
+        boost::contract::check c = boost::contract::public_function(this)
+            .postcondition([&] {
+                BOOST_CONTRACT_ASSERT(v.size() == old_v->size() + 1);
+                for(std::size_t i = 0; i < old_v->size(); ++i) {
+                    BOOST_CONTRACT_ASSERT(v[i] == (*old_v)[i]);
+                }
+                BOOST_CONTRACT_ASSERT(v[v.size() - 1] == x);
+            })
+        ;
+        v.push_back(x);
+    }
+};
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        #define BOOST_CONTRACT_TEST_old(x) x
+    #else
+        #define BOOST_CONTRACT_TEST_old(x) 0
+    #endif
+
+    a aa;
+    aa.push_back(1);
+    aa.push_back(2);
+    BOOST_TEST_EQ(aa.v.size(), 2u);
+    BOOST_TEST_EQ(cow_vector::deep_copies, BOOST_CONTRACT_TEST_old(2u));
+
+    cow_vector::deep_copies = 0;
+    for(int i = 0; i < 10; ++i) BOOST_TEST_EQ(aa.front(), 1);
+    BOOST_TEST_EQ(cow_vector::deep_copies, 0u); // Not mutated, so no copy.
+
+    aa.push_back(3);
+    BOOST_TEST_EQ(aa.v.size(), 3u);
+    BOOST_TEST_EQ(aa.v[2], 3);
+    // One copy made on mutation.
+    BOOST_TEST_EQ(cow_vector::deep_copies, BOOST_CONTRACT_TEST_old(1u));
+
+    #undef BOOST_CONTRACT_TEST_old
+    return boost::report_errors();
+}
+
@@ -0,0 +1,246 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contract kinds selected per class by policy.
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/contract_policy.hpp>
+#include <boost/contract/constructor.hpp>
+#include <boost/contract/destructor.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/override.hpp>
+#include <boost/contract/base_types.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+
+boost::contract::test::detail::oteststream out;
+
+struct b {
+    static void static_invariant() { out << "b::static_inv" << std::endl; }
+    void invariant() const { out << "b::inv" << std::endl; }
+
+    virtual void f(bool pre_ok, boost::contract::virtual_* v = 0) {
+        boost::contract::check c = boost::contract::public_function(v, this)
+            .precondition([&] {
+                out << "b::f::pre" << std::endl;
+                BOOST_CONTRACT_ASSERT(pre_ok);
+            })
+            .postcondition([] { out << "b::f::post" << std::endl; })
+        ;
+        out << "b::f::body" << std::endl;
+    }
+    virtual ~b() {}
+};
+
+struct d; // Hot class (checks only entry invariants).
+
+namespace boost { namespace contract {
+    template<> // Specialized before instantiated by contracts of d.
+    struct contract_policy<d> : boost::integral_constant<unsigned,
+            policy_entry_invariants> {};
+} } // namespace
+
+struct d
+    #define BASES \
+        private boost::contract::constructor_precondition<d>, public b
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    static void static_invariant() { out << "d::static_inv" << std::endl; }
+    void invariant() const { out << "d::inv" << std::endl; }
+
+    d() : boost::contract::constructor_precondition<d>([] {
+        out << "d::ctor::pre" << std::endl;
+    }) {
+        boost::contract::check c = boost::contract::constructor(this)
+            .postcondition([] { out << "d::ctor::post" << std::endl; })
+        ;
+        out << "d::ctor::body" << std::endl;
+    }
+
+    virtual ~d() {
+        boost::contract::check c = boost::contract::destructor(this)
+            .postcondition([] { out << "d::dtor::post" << std::endl; })
+        ;
+        out << "d::dtor::body" << std::endl;
+    }
+
+    void f(bool pre_ok, boost::contract::virtual_* v = 0) /* override */ {
+        boost::contract::old_ptr<int> old_x;
+        boost::contract::check c = boost::contract::public_function<
+                override_f>(v, &d::f, this, pre_ok)
+            .precondition([] { out << "d::f::pre" << std::endl; })
+            .old([&] {
+                out << "d::f::old" << std::endl;
+                old_x = BOOST_CONTRACT_OLDOF(v, 0);
+            })
+            .postcondition([] { out << "d::f::post" << std::endl; })
+            .except([] { out << "d::f::except" << std::endl; })
+        ;
+        out << "d::f::body" << std::endl;
+    }
+    BOOST_CONTRACT_OVERRIDE(f)
+};
+
+struct n; // Cold class (checks no contract, so none allocated).
+
+namespace boost { namespace contract {
+    template<>
+    struct contract_policy<n> : boost::integral_constant<unsigned,
+            policy_none> {};
+} } // namespace
+
+struct n {
+    static void static_invariant() { out << "n::static_inv" << std::endl; }
+    void invariant() const { out << "n::inv" << std::endl; }
+
+    n() {
+        boost::contract::check c = boost::contract::constructor(this)
+            .postcondition([] { out << "n::ctor::post" << std::endl; })
+        ;
+        out << "n::ctor::body" << std::endl;
+    }
+
+    ~n() {
+        boost::contract::check c = boost::contract::destructor(this)
+            .postcondition([] { out << "n::dtor::post" << std::endl; })
+        ;
+        out << "n::dtor::body" << std::endl;
+    }
+
+    void f() {
+        BOOST_STATIC_ASSERT((boost::is_same<
+            decltype(boost::contract::public_function(this)),
+            boost::contract::specify_precondition_old_postcondition_except<>
+        >::value)); // Same type (so same order checks) but no contract inside.
+        boost::contract::check c = boost::contract::public_function(this)
+            .precondition([] { out << "n::f::pre" << std::endl; })
+            .old([] { out << "n::f::old" << std::endl; })
+            .postcondition([] { out << "n::f::post" << std::endl; })
+        ;
+        out << "n::f::body" << std::endl;
+    }
+
+    static void s() {
+        boost::contract::check c = boost::contract::public_function<n>()
+            .precondition([] { out << "n::s::pre" << std::endl; })
+        ;
+        out << "n::s::body" << std::endl;
+    }
+};
+
+struct err {};
+void throw_err(boost::contract::from) { throw err(); }
+
+int main() {
+    std::ostringstream ok;
+    boost::contract::set_precondition_failure(&throw_err);
+
+    {
+        out.str("");
+        d dd;
+        ok.str(""); ok // No pre, exit inv, or post of d.
+            #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                << "d::static_inv" << std::endl
+            #endif
+            << "d::ctor::body" << std::endl
+        ;
+        BOOST_TEST(out.eq(ok.str()));
+
+        out.str("");
+        dd.f(true);
+        ok.str(""); ok
+            #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                << "b::static_inv" << std::endl
+                << "b::inv" << std::endl
+                << "d::static_inv" << std::endl
+                << "d::inv" << std::endl
+            #endif
+            #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+                << "b::f::pre" << std::endl // Pre of b checked as usual.
+            #endif
+            // No pre and old value copies of d (as no post and no except).
+            << "d::f::body" << std::endl
+            // No exit inv and post of d, but b checked as usual.
+            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                << "b::static_inv" << std::endl
+                << "b::inv" << std::endl
+            #endif
+            #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                << "b::f::post" << std::endl
+            #endif
+        ;
+        BOOST_TEST(out.eq(ok.str()));
+
+        out.str("");
+        bool failed = false;
+        try { dd.f(false); } // Pre of d not checked, so pre of b fails.
+        catch(err const&) { failed = true; }
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            BOOST_TEST(failed);
+        #else
+            BOOST_TEST(!failed);
+        #endif
+
+        out.str("");
+    } // Destruct dd.
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << "d::static_inv" << std::endl
+            << "d::inv" << std::endl
+        #endif
+        << "d::dtor::body" << std::endl
+        // No exit static inv or post of d.
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    b bb;
+    out.str("");
+    bb.f(true); // Contracts of b checked as usual.
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << "b::static_inv" << std::endl
+            << "b::inv" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "b::f::pre" << std::endl
+        #endif
+        << "b::f::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            << "b::static_inv" << std::endl
+            << "b::inv" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            << "b::f::post" << std::endl
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    out.str("");
+    {
+        n nn;
+        nn.f();
+        n::s();
+    }
+    ok.str(""); ok // No contract of n checked.
+        << "n::ctor::body" << std::endl
+        << "n::f::body" << std::endl
+        << "n::s::body" << std::endl
+        << "n::dtor::body" << std::endl
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,171 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test subcontracting checks each invariant at most once per entry and exit
+// (without calling overridden bases just to check their invariants).
+
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/override.hpp>
+#include <boost/contract/base_types.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+int base_calls = 0; // Calls to overridden functions (to subcontract).
+
+struct a {
+    static int static_invs, invs;
+
+    static void static_invariant() { ++static_invs; }
+    void invariant() const { ++invs; }
+
+    virtual void f(boost::contract::virtual_* v = 0) {
+        if(v) ++base_calls;
+        boost::contract::check c = boost::contract::public_function(v, this);
+    }
+};
+int a::static_invs = 0, a::invs = 0;
+
+struct b // Inherits invariants from a.
+    #define BASES public virtual a
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    virtual void f(boost::contract::virtual_* v = 0) /* override */ {
+        if(v) ++base_calls;
+        boost::contract::check c = boost::contract::public_function<
+                override_f>(v, &b::f, this);
+    }
+    BOOST_CONTRACT_OVERRIDE(f)
+};
+
+struct c // Also inherits invariants from a.
+    #define BASES public virtual a
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    virtual void f(boost::contract::virtual_* v = 0) /* override */ {
+        if(v) ++base_calls;
+        boost::contract::check c = boost::contract::public_function<
+                override_f>(v, &c::f, this);
+    }
+    BOOST_CONTRACT_OVERRIDE(f)
+};
+
+struct d // Wide hierarchy (and a reachable via multiple paths).
+    #define BASES public b, public c
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    static int static_invs, invs;
+
+    static void static_invariant() { ++static_invs; }
+    void invariant() const { ++invs; }
+
+    virtual void f(boost::contract::virtual_* v = 0) /* override */ {
+        if(v) ++base_calls;
+        boost::contract::check c = boost::contract::public_function<
+                override_f>(v, &d::f, this);
+    }
+    BOOST_CONTRACT_OVERRIDE(f)
+};
+int d::static_invs = 0, d::invs = 0;
+
+struct e // Inherits invariants from d (and so indirectly from a).
+    #define BASES public d
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    virtual void f(boost::contract::virtual_* v = 0) /* override */ {
+        if(v) ++base_calls;
+        boost::contract::check c = boost::contract::public_function<
+                override_f>(v, &e::f, this);
+    }
+    BOOST_CONTRACT_OVERRIDE(f)
+};
+
+int main() {
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #define BOOST_CONTRACT_TEST_entry 1
+    #else
+        #define BOOST_CONTRACT_TEST_entry 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        #define BOOST_CONTRACT_TEST_exit 1
+    #else
+        #define BOOST_CONTRACT_TEST_exit 0
+    #endif
+    int const once = BOOST_CONTRACT_TEST_entry + BOOST_CONTRACT_TEST_exit;
+    #undef BOOST_CONTRACT_TEST_entry
+    #undef BOOST_CONTRACT_TEST_exit
+    
+    // Bases called only for preconditions, old values, and postconditions.
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        #define BOOST_CONTRACT_TEST_pre 1
+    #else
+        #define BOOST_CONTRACT_TEST_pre 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        #define BOOST_CONTRACT_TEST_old 2 // Init and functor copies.
+    #else
+        #define BOOST_CONTRACT_TEST_old 0
+    #endif
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        #define BOOST_CONTRACT_TEST_post 1
+    #else
+        #define BOOST_CONTRACT_TEST_post 0
+    #endif
+    int const calls = BOOST_CONTRACT_TEST_pre + BOOST_CONTRACT_TEST_old +
+            BOOST_CONTRACT_TEST_post; // Per overridden base.
+    #undef BOOST_CONTRACT_TEST_pre
+    #undef BOOST_CONTRACT_TEST_old
+    #undef BOOST_CONTRACT_TEST_post
+
+    a aa;
+    aa.f();
+    BOOST_TEST_EQ(a::static_invs, once);
+    BOOST_TEST_EQ(a::invs, once);
+
+    a::static_invs = a::invs = 0;
+    b bb;
+    bb.f(); // Checked by a::f and b::f (but just once).
+    BOOST_TEST_EQ(a::static_invs, once);
+    BOOST_TEST_EQ(a::invs, once);
+
+    a::static_invs = a::invs = 0;
+    d dd;
+    dd.f(); // Checked by a::f, b::f, c::f, and d::f.
+    BOOST_TEST_EQ(a::static_invs, once);
+    BOOST_TEST_EQ(a::invs, once);
+    BOOST_TEST_EQ(d::static_invs, once);
+    BOOST_TEST_EQ(d::invs, once);
+
+    a::static_invs = a::invs = d::static_invs = d::invs = 0;
+    e ee;
+    base_calls = 0;
+    ee.f(); // Checked by a::f, b::f, c::f, d::f, and e::f.
+    BOOST_TEST_EQ(a::static_invs, once);
+    BOOST_TEST_EQ(a::invs, once);
+    BOOST_TEST_EQ(d::static_invs, once);
+    BOOST_TEST_EQ(d::invs, once);
+    BOOST_TEST_EQ(base_calls, 4 * calls); // Overridden d::f, b::f, a::f, c::f.
+
+    a::static_invs = a::invs = d::static_invs = d::invs = 0;
+    ee.f(); // Again (so cleared between calls).
+    ee.f();
+    BOOST_TEST_EQ(a::invs, 2 * once);
+    BOOST_TEST_EQ(d::invs, 2 * once);
+
+    return boost::report_errors();
+}
+